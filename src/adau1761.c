@@ -26,7 +26,7 @@ unsigned char Adau1761_Init(tAdau1761 *pThis)
 	Adau1761_FIFO_Init(pThis);
 
 	/* Audio Input Path Source Select - MIC/Line IN, L/R Input Volume  */
-	Adau1761_InSelect(pThis, LINE_MIC, 0xFF, 0xFF);
+	Adau1761_InSelect(pThis, LINE_MIC, IN_VOL_DEFAULT, IN_VOL_DEFAULT);
 
 	return PASS;
 }
@@ -41,7 +41,7 @@ void Adau1761_InSelect(tAdau1761 *pThis, unsigned short In_Sel, unsigned short L
 			Adau1761_RegWrite(pThis, R8_LEFT_DIFFERENTIAL_INPUT_VOLUME_CONTROL, L_In_Vol); //Set Input Volume - Check datasheet for more options.
 			Adau1761_RegWrite(pThis, R9_RIGHT_DIFFERENTIAL_INPUT_VOLUME_CONTROL, R_In_Vol);
 			Adau1761_RegWrite(pThis, R10_RECORD_MICROPHONE_BIAS_CONTROL, 0x01); // Bias Control enabled and set to default.
-			Adau1761_RegWrite(pThis, R11_ALC_CONTROL_0, 0x13); // ALC controls PGA - Here its set to stereo.
+			Adau1761_RegWrite(pThis, R11_ALC_CONTROL_0, 0x00); // ALC off - PGA gain is set by the software AGC.
 			Adau1761_RegWrite(pThis, R5_RECORD_MIXER_LEFT_CONTROL_1, 0x10); //20dB LDBOOST, Line In Disabled.
 			Adau1761_RegWrite(pThis, R7_RECORD_MIXER_RIGHT_CONTROL_1, 0x10);//20dB LD Boost, Line In Disabled.
 			break;
@@ -56,7 +56,7 @@ void Adau1761_InSelect(tAdau1761 *pThis, unsigned short In_Sel, unsigned short L
 			Adau1761_RegWrite(pThis, R8_LEFT_DIFFERENTIAL_INPUT_VOLUME_CONTROL, L_In_Vol);
 			Adau1761_RegWrite(pThis, R9_RIGHT_DIFFERENTIAL_INPUT_VOLUME_CONTROL, R_In_Vol);
 			Adau1761_RegWrite(pThis, R10_RECORD_MICROPHONE_BIAS_CONTROL, 0x01); // Bias Control enabled and set to default.
-			Adau1761_RegWrite(pThis, R11_ALC_CONTROL_0, 0x13); // ALC controls PGA - Here its set to stereo.
+			Adau1761_RegWrite(pThis, R11_ALC_CONTROL_0, 0x00); // ALC off - PGA gain is set by the software AGC.
 			/* Line IN and LD Boost (output of PGA) Configurations */
 			Adau1761_RegWrite(pThis, R5_RECORD_MIXER_LEFT_CONTROL_1, 0x17); //Zero gain LD Boost, Enable Line In.
 			Adau1761_RegWrite(pThis, R7_RECORD_MIXER_RIGHT_CONTROL_1, 0x17);//Zero gain LD Boost, Enable Line In.
@@ -67,6 +67,14 @@ void Adau1761_InSelect(tAdau1761 *pThis, unsigned short In_Sel, unsigned short L
 	}
 }
 
+/* Input PGA Gain - Refer Page 30, written by the software AGC (ALC is off) */
+void Adau1761_SetIn_PgaVol(tAdau1761 *pThis, unsigned short L_In_Vol, unsigned short R_In_Vol){
+
+	/* MIC PGA Vol Control - Range: PGA_VOL_REG(0) - PGA_VOL_REG(PGA_STEP_MAX) (-12dB to 35.25dB) */
+	Adau1761_RegWrite(pThis, R8_LEFT_DIFFERENTIAL_INPUT_VOLUME_CONTROL, L_In_Vol);
+	Adau1761_RegWrite(pThis, R9_RIGHT_DIFFERENTIAL_INPUT_VOLUME_CONTROL, R_In_Vol);
+}
+
 /* Output Volume Control - HPH Vol could be controlled the same way */
 void AudioPlayer_SetOut_LineVol(tAdau1761 *pThis, unsigned short Line_Vol){
 
@@ -247,8 +255,8 @@ void Adau1761_FIFO_Init(tAdau1761 *pThis)
 	/* clear all pending interrupts */
 	*(volatile u32 *) (FIFO_BASE_ADDR + FIFO_INT_STATUS) = 0xffffffff;
 
-	/* Enable TFPE interrupt to propagate */
-	*(volatile u32 *) (FIFO_BASE_ADDR + FIFO_INT_ENABLE) =  (FIFO_INT_RFPF) | (FIFO_INT_TFPE);
+	/* Enable RFPF interrupt to propagate, TFPE is enabled once the TX FIFO is primed */
+	*(volatile u32 *) (FIFO_BASE_ADDR + FIFO_INT_ENABLE) =  (FIFO_INT_RFPF);
 
 }
 
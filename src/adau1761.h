@@ -36,6 +36,16 @@ void Adau1761_RegWrite(tAdau1761*, unsigned char, unsigned char);
 void Adau1761_InSelect(tAdau1761*, unsigned short, unsigned short, unsigned short);
 
 void AudioPlayer_SetOut_LineVol(tAdau1761*, unsigned short);
+/* Input PGA Gain - MIC differential inputs, L/R register values (PGA_VOL_REG) */
+void Adau1761_SetIn_PgaVol(tAdau1761*, unsigned short, unsigned short);
+
+/* Input PGA (R8/R9): LDVOL[7:2] in 0.75dB steps from -12dB, LDMUTE[1] set = unmuted, LDEN[0] */
+#define PGA_STEP_MAX      0x3F /* +35.25dB */
+#define PGA_STEP_0DB      0x10
+#define PGA_STEP_DB       0.75
+#define PGA_VOL_REG(step) ((unsigned short) (((step) << 2) | 0x03))
+#define PGA_STEP_DEFAULT  PGA_STEP_MAX /* startup step, analog gain of the former ALC setup (0xFF) */
+#define IN_VOL_DEFAULT    PGA_VOL_REG(PGA_STEP_DEFAULT) /* startup input volume, the AGC levels digitally */
 
 											      /* FIFO MMR Addresses */
 
@@ -0,0 +1,152 @@
+/**
+ *@file adpcm.c
+ *
+ *@brief
+ *  - IMA-ADPCM streaming decoder for the compressed sample bank
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#include <stdio.h>
+#include "adpcm.h"
+#include "zedboard_freertos.h"
+
+const short adpcm_stepTable[89] = {
+	    7,     8,     9,    10,    11,    12,    13,    14,    16,    17,
+	   19,    21,    23,    25,    28,    31,    34,    37,    41,    45,
+	   50,    55,    60,    66,    73,    80,    88,    97,   107,   118,
+	  130,   143,   157,   173,   190,   209,   230,   253,   279,   307,
+	  337,   371,   408,   449,   494,   544,   598,   658,   724,   796,
+	  876,   963,  1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,
+	 2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,
+	 5894,  6484,  7132,  7845,  8630,  9493, 10442, 11487, 12635, 13899,
+	15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+const signed char adpcm_indexTable[16] = {
+	-1, -1, -1, -1, 2, 4, 6, 8,
+	-1, -1, -1, -1, 2, 4, 6, 8
+};
+
+/** Initialize decoder on a clip and rewind to its start
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ * @param pClip  clip to decode
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure.
+ */
+int adpcm_decoder_init(adpcm_decoder_t *pThis, const adpcm_clip_t *pClip) {
+	if (NULL == pThis || NULL == pClip || pClip->blockAlign <= ADPCM_BLOCK_HEADER) {
+		printf("[ADPCM]: Failed Init\r\n");
+		return -1;
+	}
+
+	pThis->pClip = pClip;
+	adpcm_decoder_rewind(pThis);
+	return PASS;
+}
+
+/** Rewind decoder to the start of its clip
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ */
+void adpcm_decoder_rewind(adpcm_decoder_t *pThis) {
+	pThis->block     = 0;
+	pThis->pos       = 0;
+	pThis->remaining = pThis->pClip->nSamples;
+	pThis->predictor = 0;
+	pThis->index     = 0;
+}
+
+/** Decode the next samples of the clip
+ *   - continues where the previous call stopped (may span blocks)
+ *   - output is 16 bit signed PCM, one sample per element
+ *
+ * Parameters:
+ * @param pThis      pointer to own object
+ * @param pOut       destination for decoded samples
+ * @param maxSamples maximum number of samples to decode
+ *
+ * @return number of samples decoded, 0 at end of clip
+ */
+int adpcm_decode(adpcm_decoder_t *pThis, short *pOut, int maxSamples) {
+	const unsigned int blockAlign      = pThis->pClip->blockAlign;
+	const unsigned int samplesPerBlock = ADPCM_SAMPLES_PER_BLOCK(blockAlign);
+	int predictor = pThis->predictor;
+	int index     = pThis->index;
+	int decoded   = 0;
+
+	if ((unsigned int) maxSamples > pThis->remaining) {
+		maxSamples = pThis->remaining;
+	}
+
+	while (decoded < maxSamples) {
+		const unsigned char *pBlock = &pThis->pClip->pData[pThis->block * blockAlign];
+		unsigned int run;
+		unsigned int n;
+
+		/* block header carries the first sample and the step index */
+		if (0 == pThis->pos) {
+			predictor = (short) (pBlock[0] | (pBlock[1] << 8));
+			index     = pBlock[2];
+			if (index > 88) {
+				index = 88;
+			}
+			pOut[decoded++] = (short) predictor;
+			pThis->pos = 1;
+			continue;
+		}
+
+		/* decode as many codes as fit in this block and in the request */
+		run = samplesPerBlock - pThis->pos;
+		if (run > (unsigned int) (maxSamples - decoded)) {
+			run = maxSamples - decoded;
+		}
+
+		for (n = 0; n < run; n++) {
+			unsigned int code = pThis->pos - 1;
+			unsigned char nibble = pBlock[ADPCM_BLOCK_HEADER + (code >> 1)];
+			int step = adpcm_stepTable[index];
+			int diff = step >> 3;
+
+			nibble = (code & 1) ? (nibble >> 4) : (nibble & 0x0F);
+
+			if (nibble & 4) diff += step;
+			if (nibble & 2) diff += step >> 1;
+			if (nibble & 1) diff += step >> 2;
+
+			if (nibble & 8) {
+				predictor -= diff;
+				if (predictor < -32768) predictor = -32768;
+			} else {
+				predictor += diff;
+				if (predictor > 32767) predictor = 32767;
+			}
+
+			index += adpcm_indexTable[nibble];
+			if (index < 0)  index = 0;
+			if (index > 88) index = 88;
+
+			pOut[decoded++] = (short) predictor;
+			pThis->pos++;
+		}
+
+		/* advance to next block */
+		if (pThis->pos >= samplesPerBlock) {
+			pThis->pos = 0;
+			pThis->block++;
+		}
+	}
+
+	pThis->predictor  = predictor;
+	pThis->index      = index;
+	pThis->remaining -= decoded;
+	return decoded;
+}
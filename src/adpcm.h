@@ -0,0 +1,106 @@
+/**
+ *@file adpcm.h
+ *
+ *@brief
+ *  - IMA-ADPCM (4 bit) clip description and streaming decoder
+ *
+ * Clips are stored as a sequence of fixed size blocks using the IMA/DVI
+ * layout known from WAV files (mono):
+ *   - 4 byte header: predictor (16 bit, little endian), step index, reserved
+ *   - (blockAlign - 4) bytes of 4 bit codes, low nibble first
+ * Each block therefore holds (blockAlign - 4) * 2 + 1 samples. The clip
+ * tables are produced offline by tools/wav2adpcm.c.
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#ifndef _ADPCM_H_
+#define _ADPCM_H_
+
+/***************************************************
+            DEFINES
+***************************************************/
+
+/**
+ * @def ADPCM_BLOCK_HEADER
+ * @brief bytes of block header (predictor + step index + reserved)
+ */
+#define ADPCM_BLOCK_HEADER 4
+
+/**
+ * @def ADPCM_SAMPLES_PER_BLOCK
+ * @brief number of samples stored in one block of blockAlign bytes
+ */
+#define ADPCM_SAMPLES_PER_BLOCK(blockAlign) ((((blockAlign) - ADPCM_BLOCK_HEADER) * 2) + 1)
+
+/***************************************************
+            DATA TYPES
+***************************************************/
+
+/** ADPCM clip (one entry of the sample bank)
+ */
+typedef struct {
+  const char          *name;       /* clip name (source file name) */
+  const unsigned char *pData;      /* encoded blocks */
+  unsigned int         nBytes;     /* size of pData in bytes */
+  unsigned int         blockAlign; /* bytes per block */
+  unsigned int         nSamples;   /* decoded length in samples */
+  unsigned int         sampleRate; /* sampling rate the clip was recorded at */
+} adpcm_clip_t;
+
+/** ADPCM streaming decoder state
+ */
+typedef struct {
+  const adpcm_clip_t *pClip;     /* clip being decoded */
+  unsigned int        block;     /* current block number */
+  unsigned int        pos;       /* next sample within current block */
+  unsigned int        remaining; /* samples left until end of clip */
+  int                 predictor; /* last decoded sample */
+  int                 index;     /* step table index */
+} adpcm_decoder_t;
+
+
+/***************************************************
+            Access Methods
+***************************************************/
+
+/** Initialize decoder on a clip and rewind to its start
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ * @param pClip  clip to decode
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure.
+ */
+int adpcm_decoder_init(adpcm_decoder_t *pThis, const adpcm_clip_t *pClip);
+
+/** Rewind decoder to the start of its clip
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ */
+void adpcm_decoder_rewind(adpcm_decoder_t *pThis);
+
+/** Decode the next samples of the clip
+ *   - continues where the previous call stopped (may span blocks)
+ *   - output is 16 bit signed PCM, one sample per element
+ *
+ * Parameters:
+ * @param pThis      pointer to own object
+ * @param pOut       destination for decoded samples
+ * @param maxSamples maximum number of samples to decode
+ *
+ * @return number of samples decoded, 0 at end of clip
+ */
+int adpcm_decode(adpcm_decoder_t *pThis, short *pOut, int maxSamples);
+
+/* step size / index adaption tables (shared with the offline encoder) */
+extern const short adpcm_stepTable[89];
+extern const signed char adpcm_indexTable[16];
+
+#endif
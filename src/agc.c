@@ -0,0 +1,194 @@
+/**
+ *@file agc.c
+ *
+ *@brief
+ *  - automatic gain control for the live input
+ *
+ * Per block of AGC_BLOCK frames: rms = sqrt(energy / N) over the
+ * N = AGC_BLOCK * AGC_CHANNELS samples of the block, the wanted fine
+ * gain is target / rms (at most maxGain over the coarse gain), the gain
+ * moves toward it by the attack or release share and the next block ramps
+ * to the new value. The coarse gain only moves when the fine gain leaves
+ * AGC_FINE_LOW..AGC_FINE_HIGH, then back toward unity fine gain by at most
+ * AGC_COARSE_MOVE steps. Samples already in flight were taken with the old
+ * coarse gain, so a change shows as a short step of that size.
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#include <string.h>
+#include "agc.h"
+#include "dspMath.h"
+#include "zedboard_freertos.h"
+
+/* fine gain window, the coarse gain takes over outside (+-6 dB) */
+#define AGC_FINE_HIGH    2.0f
+#define AGC_FINE_LOW     0.5f
+
+/* largest coarse change per request (steps) */
+#define AGC_COARSE_MOVE  4
+
+/* full scale of an S16 sample */
+#define AGC_FULL_SCALE   32768.0
+
+/* share of the error corrected per block for a time constant */
+static float agc_coeff(unsigned int tauMs, unsigned int sampleRate)
+{
+	if (0 == tauMs) {
+		return 1.0f;
+	}
+	return (float) (1.0 - dspMath_exp(-(double) AGC_BLOCK * 1000.0 / ((double) tauMs * sampleRate)));
+}
+
+/* Initialize the AGC */
+int agc_init(agc_t *pThis, const agc_config_t *pCfg, int coarseStep, unsigned int sampleRate)
+{
+	double gate;
+
+	if (0 == sampleRate || pCfg->targetDb > 0 || pCfg->maxGainDb < 0) {
+		printf("[AGC]: invalid target %d dBFS / max gain %d dB\r\n", pCfg->targetDb, pCfg->maxGainDb);
+		return FAIL;
+	}
+	if (pCfg->coarse && (coarseStep < pCfg->coarseMin || coarseStep > pCfg->coarseMax)) {
+		printf("[AGC]: coarse step %d out of range\r\n", coarseStep);
+		return FAIL;
+	}
+
+	memset(pThis, 0, sizeof(*pThis));
+	pThis->target     = (float) (dspMath_dbToLin(pCfg->targetDb) * AGC_FULL_SCALE);
+	pThis->maxGain    = (float) dspMath_dbToLin(pCfg->maxGainDb);
+	gate              = dspMath_dbToLin(pCfg->gateDb) * AGC_FULL_SCALE;
+	pThis->gateEnergy = (float) (gate * gate * AGC_BLOCK * AGC_CHANNELS);
+	pThis->attack     = agc_coeff(pCfg->attackMs, sampleRate);
+	pThis->release    = agc_coeff(pCfg->releaseMs, sampleRate);
+	pThis->gain       = 1.0f;
+
+	/* coarse gain relative to its 0 dB step */
+	pThis->coarse     = pCfg->coarse;
+	pThis->coarseLin  = 1.0f;
+	pThis->coarseGain = 1.0f;
+	pThis->coarseStep = coarseStep;
+	if (pThis->coarse) {
+		pThis->coarseLin  = (float) dspMath_dbToLin(pCfg->coarseStepDb);
+		pThis->coarseGain = (float) dspMath_dbToLin(pCfg->coarseStepDb * (coarseStep - pCfg->coarseZero));
+		pThis->coarseMin  = pCfg->coarseMin;
+		pThis->coarseMax  = pCfg->coarseMax;
+	}
+	pThis->coarseDone    = coarseStep;
+	pThis->coarseRequest = AGC_COARSE_NONE;
+
+	return PASS;
+}
+
+/* Block complete: new fine gain target, coarse request */
+static void agc_update(agc_t *pThis)
+{
+	int done = pThis->coarseDone;
+	float next;
+
+	/* coarse step written meanwhile: the fine gain keeps the total */
+	for (; pThis->coarseStep < done; pThis->coarseStep++) {
+		pThis->coarseGain *= pThis->coarseLin;
+		pThis->gain       /= pThis->coarseLin;
+	}
+	for (; pThis->coarseStep > done; pThis->coarseStep--) {
+		pThis->coarseGain /= pThis->coarseLin;
+		pThis->gain       *= pThis->coarseLin;
+	}
+
+	/* follow the level, hold below the gate */
+	next = pThis->gain;
+	if (pThis->energy > pThis->gateEnergy) {
+		float want  = pThis->target * dspMath_sqrtf((float) (AGC_BLOCK * AGC_CHANNELS) / pThis->energy);
+		float limit = pThis->maxGain / pThis->coarseGain;
+
+		if (want > limit) {
+			want = limit;
+		}
+		next += (want - next) * ((want < next) ? pThis->attack : pThis->release);
+	}
+	pThis->step   = (next - pThis->gain) / (float) AGC_BLOCK;
+	pThis->energy = 0.0f;
+	pThis->count  = 0;
+
+	/* fine gain outside its window: move the coarse gain (one request at a time) */
+	if (pThis->coarse && AGC_COARSE_NONE == pThis->coarseRequest && done == pThis->coarseStep) {
+		int step = done;
+		float fine = next;
+
+		if (fine > AGC_FINE_HIGH) {
+			while (fine > 1.0f && step < pThis->coarseMax && step < done + AGC_COARSE_MOVE) {
+				fine /= pThis->coarseLin;
+				step++;
+			}
+		} else if (fine < AGC_FINE_LOW) {
+			while (fine < 1.0f && step > pThis->coarseMin && step > done - AGC_COARSE_MOVE) {
+				fine *= pThis->coarseLin;
+				step--;
+			}
+		}
+		if (step != done) {
+			pThis->coarseRequest = step;
+		}
+	}
+}
+
+/* Level an interleaved stereo S16 chunk in place */
+int agc_process(agc_t *pThis, chunk_d_t *pChunk)
+{
+	short *p = pChunk->s16_buff;
+	unsigned int frames = pChunk->bytesUsed / sizeof(unsigned int) / AGC_CHANNELS;
+
+	if (CHUNK_FMT_S16 != pChunk->format || AGC_CHANNELS != pChunk->channels) {
+		return FAIL;
+	}
+
+	/* a chunk may end a block and start the next */
+	while (frames) {
+		unsigned int n = AGC_BLOCK - pThis->count;
+		float energy = pThis->energy;
+		float gain = pThis->gain, step = pThis->step;
+		unsigned int i, c;
+
+		if (n > frames) {
+			n = frames;
+		}
+		for (i = 0; i < n; i++) {
+			for (c = 0; c < AGC_CHANNELS; c++) {
+				float x = (float) p[AGC_CHANNELS * i + c];
+				float y = x * gain;
+
+				energy += x * x;
+				p[AGC_CHANNELS * i + c] = (y >= 32767.0f) ? 32767 : (y <= -32768.0f) ? -32768 : (short) y;
+			}
+			gain += step;
+		}
+		pThis->energy = energy;
+		pThis->gain   = gain;
+		pThis->count += n;
+		p            += n * AGC_CHANNELS;
+		frames       -= n;
+
+		if (AGC_BLOCK == pThis->count) {
+			agc_update(pThis);
+		}
+	}
+	return PASS;
+}
+
+/* Coarse step the control task has to write */
+int agc_coarsePending(const agc_t *pThis)
+{
+	return pThis->coarseRequest;
+}
+
+/* Report a coarse step written to the codec */
+void agc_coarseDone(agc_t *pThis, int step)
+{
+	pThis->coarseDone    = step;
+	pThis->coarseRequest = AGC_COARSE_NONE;
+}
@@ -0,0 +1,131 @@
+/**
+ *@file agc.h
+ *
+ *@brief
+ *  - automatic gain control for the live input (RX chunks)
+ *  - level estimate: RMS of blocks of AGC_BLOCK L/R frames collected
+ *    across chunks, per sample work is one multiply-add for the energy and
+ *    one multiply for the gain (O(1)); both channels share one gain
+ *  - the gain follows target / RMS with separate attack (gain down) and
+ *    release (gain up) time constants, limited to the maximum gain; blocks
+ *    below the noise gate hold the gain so silence is not pulled up
+ *  - the gain ramps linearly over a block, no steps at block borders
+ *  - optional coarse gain in the codec PGA: the AGC requests a step change
+ *    when the fine gain leaves its window, a control task writes the
+ *    register (I2C) and reports it done, the fine gain then compensates
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#ifndef _AGC_H_
+#define _AGC_H_
+
+#include "chunk_d.h"
+
+/***************************************************
+            DEFINES
+***************************************************/
+
+/** frames per level estimate (5.3 ms at 48 kHz) */
+#define AGC_BLOCK          256
+
+/** interleaved channels of the live input */
+#define AGC_CHANNELS       2
+
+/** no coarse gain change requested */
+#define AGC_COARSE_NONE    (-1)
+
+/***************************************************
+            DATA TYPES
+***************************************************/
+
+/** AGC settings */
+typedef struct {
+  int           targetDb;     /* output RMS, dBFS */
+  int           maxGainDb;    /* largest total gain (coarse + fine) */
+  unsigned int  attackMs;     /* time constant of gain decrease */
+  unsigned int  releaseMs;    /* time constant of gain increase */
+  int           gateDb;       /* input RMS below this holds the gain, dBFS */
+  int           coarse;       /* non-zero: request coarse steps */
+  double        coarseStepDb; /* gain of one coarse step */
+  int           coarseMin;    /* coarse step range */
+  int           coarseMax;
+  int           coarseZero;   /* coarse step of 0 dB */
+} agc_config_t;
+
+/** AGC object */
+typedef struct {
+  float         target;       /* output RMS (32768 full scale) */
+  float         maxGain;      /* total gain limit */
+  float         gateEnergy;   /* block energy of the gate level */
+  float         attack;       /* share of the gain error corrected per block */
+  float         release;
+  float         gain;         /* fine gain of the next frame */
+  float         step;         /* fine gain ramp per frame */
+  float         energy;       /* sum of x^2 of the current block */
+  unsigned int  count;        /* frames in the current block */
+  int           coarse;       /* coarse steps enabled */
+  float         coarseLin;    /* gain of one coarse step */
+  float         coarseGain;   /* gain of the coarse step in effect */
+  int           coarseStep;   /* coarse step in effect */
+  int           coarseMin;
+  int           coarseMax;
+  volatile int  coarseRequest;  /* step to write, AGC_COARSE_NONE if none */
+  volatile int  coarseDone;     /* step written by the control task */
+} agc_t;
+
+
+/***************************************************
+            Access Methods
+***************************************************/
+
+/** Initialize the AGC at unity fine gain
+ *    - not while a coarse step is pending: the control task may be
+ *      writing it (agc_coarsePending() returns AGC_COARSE_NONE)
+ *
+ * Parameters:
+ * @param pThis       pointer to own object
+ * @param pCfg        settings
+ * @param coarseStep  coarse step currently set in the codec
+ * @param sampleRate  sample rate in Hz
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure.
+ */
+int agc_init(agc_t *pThis, const agc_config_t *pCfg, int coarseStep, unsigned int sampleRate);
+
+/** Level an interleaved stereo S16 chunk in place
+ *    - L and R of a frame get the same gain
+ *
+ * Parameters:
+ * @param pThis   pointer to own object
+ * @param pChunk  chunk to level (S16, channels = AGC_CHANNELS)
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure (chunk left unchanged).
+ */
+int agc_process(agc_t *pThis, chunk_d_t *pChunk);
+
+/** Coarse step the control task has to write
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ *
+ * @return coarse step, AGC_COARSE_NONE if nothing to write
+ */
+int agc_coarsePending(const agc_t *pThis);
+
+/** Report a coarse step written to the codec (control task)
+ *    - the fine gain compensates at the next block
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ * @param step   step written
+ */
+void agc_coarseDone(agc_t *pThis, int step);
+
+#endif
@@ -0,0 +1,161 @@
+/**
+ *@file appConfig.h
+ *
+ *@brief
+ *  - application wide configuration: allocation mode, task stacks
+ *  - helpers to create tasks, queues and timers either from the FreeRTOS heap
+ *    or from static storage (APP_STATIC_ALLOC)
+ *
+ * With APP_STATIC_ALLOC set every task, queue and buffer of the
+ * application lives in .bss; running out of memory is then a link error
+ * instead of a failed allocation at runtime. It defaults to on when the
+ * kernel is configured with configSUPPORT_STATIC_ALLOCATION (FreeRTOS 9+).
+ * The kernel then also needs vApplicationGetIdleTaskMemory() and
+ * vApplicationGetTimerTaskMemory(), which are provided in main.c.
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#ifndef _APP_CONFIG_H_
+#define _APP_CONFIG_H_
+
+#include "zedboard_freertos.h"
+
+/***************************************************
+            DEFINES
+***************************************************/
+
+/**
+ * @def APP_STATIC_ALLOC
+ * @brief 1: all tasks/queues/buffers statically allocated, 0: heap
+ */
+#ifndef APP_STATIC_ALLOC
+#if defined(configSUPPORT_STATIC_ALLOCATION) && (configSUPPORT_STATIC_ALLOCATION == 1)
+#define APP_STATIC_ALLOC 1
+#else
+#define APP_STATIC_ALLOC 0
+#endif
+#endif
+
+/**
+ * @def AUDIO_SAMPLE_RATE
+ * @brief sampling rate of the audio path (Hz)
+ */
+#define AUDIO_SAMPLE_RATE 48000
+
+/**
+ * @def AUDIO_CHANNELS
+ * @brief FIFO slots per frame: chunks carry interleaved L,R samples, one
+ *        per slot, so a chunk of n slots lasts n / AUDIO_CHANNELS frames
+ */
+#define AUDIO_CHANNELS 2
+
+/**
+ * task stack sizes (in words), estimated: not yet measured on the board.
+ * DSP state and buffers live in the objects, so the deepest paths are
+ * newlib printf (~1 KB) and FatFs calls; each size is that path with
+ * about 2x margin. Check them against the high-water marks of the
+ * monitor (SYSMON_ENABLED) once the tasks ran under load.
+ *   AUDIO  all DSP stages plus printf of the reports
+ *   FILE   f_read / f_lseek plus printf
+ *   GPIO   codec I2C writes, snapshot export (f_write) plus snprintf
+ *   TTC    OLED drawing and the UI jobs, no printf
+ *   MON    uxTaskGetSystemState into a static table, no printf
+ */
+#define AUDIO_TASK_STACK (configMINIMAL_STACK_SIZE + 1024)
+#define GPIO_TASK_STACK  (configMINIMAL_STACK_SIZE + 768)
+#define TTC_TASK_STACK   (configMINIMAL_STACK_SIZE + 128)
+#define FILE_TASK_STACK  (configMINIMAL_STACK_SIZE + 768)
+#define MON_TASK_STACK   (configMINIMAL_STACK_SIZE + 128)
+
+/**
+ * task priorities, ordered by deadline:
+ *   AUDIO  one chunk period (profile samples / AUDIO_CHANNELS / AUDIO_SAMPLE_RATE)
+ *   FILE   prefetch depth * chunk period
+ *   GPIO   button response (~tens of ms)
+ *   TTC    display refresh, MON statistics: best effort
+ */
+#define AUDIO_TASK_PRIO  (tskIDLE_PRIORITY + 4)
+#define FILE_TASK_PRIO   (tskIDLE_PRIORITY + 3)
+#define GPIO_TASK_PRIO   (tskIDLE_PRIORITY + 2)
+#define TTC_TASK_PRIO    (tskIDLE_PRIORITY + 1)
+#define MON_TASK_PRIO    (tskIDLE_PRIORITY + 1)
+
+/**
+ * @def APP_STATIC_ASSERT
+ * @brief compile time check, fails the build with a negative array size
+ */
+#define APP_STATIC_ASSERT(cond, msg) typedef char app_assert_##msg[(cond) ? 1 : -1]
+
+#if APP_STATIC_ALLOC
+
+/** storage for a queue embedded in an object */
+#define APP_QUEUE_STORAGE(name, depth, itemSize) \
+	StaticQueue_t name##_qcb; \
+	unsigned char name##_qstore[(depth) * (itemSize)];
+
+/** create a queue on storage declared with APP_QUEUE_STORAGE */
+#define APP_QUEUE_CREATE(pObj, name, depth, itemSize) \
+	xQueueCreateStatic((depth), (itemSize), (pObj)->name##_qstore, &(pObj)->name##_qcb)
+
+/** create a queue on storage private to the call site (singletons only) */
+#define APP_QUEUE_CREATE_LOCAL(depth, itemSize) ({ \
+	static StaticQueue_t qcb_; \
+	static unsigned char qstore_[(depth) * (itemSize)]; \
+	xQueueCreateStatic((depth), (itemSize), qstore_, &qcb_); })
+
+/** storage for a task embedded in an object */
+#define APP_TASK_STORAGE(name, stackWords) \
+	StaticTask_t name##_tcb; \
+	StackType_t  name##_stack[stackWords];
+
+/** create a task on storage declared with APP_TASK_STORAGE, yields handle */
+#define APP_TASK_CREATE(pObj, name, fn, taskName, stackWords, arg, prio) \
+	xTaskCreateStatic((fn), (taskName), (stackWords), (arg), (prio), (pObj)->name##_stack, &(pObj)->name##_tcb)
+
+/** create a task on storage private to the call site (singletons only), yields handle */
+#define APP_TASK_CREATE_LOCAL(fn, taskName, stackWords, arg, prio) ({ \
+	static StaticTask_t tcb_; \
+	static StackType_t  stack_[stackWords]; \
+	xTaskCreateStatic((fn), (taskName), (stackWords), (arg), (prio), stack_, &tcb_); })
+
+/** storage for a software timer embedded in an object */
+#define APP_TIMER_STORAGE(name) \
+	StaticTimer_t name##_tmcb;
+
+/** create a timer on storage declared with APP_TIMER_STORAGE, yields handle */
+#define APP_TIMER_CREATE(pObj, name, timerName, period, reload, id, fn) \
+	xTimerCreateStatic((timerName), (period), (reload), (id), (fn), &(pObj)->name##_tmcb)
+
+#else
+
+#define APP_QUEUE_STORAGE(name, depth, itemSize)
+
+#define APP_QUEUE_CREATE(pObj, name, depth, itemSize) \
+	xQueueCreate((depth), (itemSize))
+
+#define APP_QUEUE_CREATE_LOCAL(depth, itemSize) \
+	xQueueCreate((depth), (itemSize))
+
+#define APP_TASK_STORAGE(name, stackWords)
+
+#define APP_TASK_CREATE(pObj, name, fn, taskName, stackWords, arg, prio) \
+	APP_TASK_CREATE_LOCAL(fn, taskName, stackWords, arg, prio)
+
+#define APP_TASK_CREATE_LOCAL(fn, taskName, stackWords, arg, prio) ({ \
+	TaskHandle_t handle_ = NULL; \
+	xTaskCreate((fn), ( signed char * ) (taskName), (stackWords), (arg), (prio), &handle_); \
+	handle_; })
+
+#define APP_TIMER_STORAGE(name)
+
+#define APP_TIMER_CREATE(pObj, name, timerName, period, reload, id, fn) \
+	xTimerCreate((timerName), (period), (reload), (id), (fn))
+
+#endif
+
+#endif
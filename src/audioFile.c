@@ -0,0 +1,343 @@
+/**
+ *@file audioFile.c
+ *
+ *@brief
+ *  - streaming audio source reading WAV/raw PCM from a file
+ *
+ * The read-ahead task owns all file I/O. It keeps up to 'prefetch' filled
+ * chunks in the ready queue; the audio task only dequeues (never blocks).
+ * Chunks use the RX/TX layout: one 16 bit sample per 32 bit FIFO word,
+ * samples packed at the start of the buffer, bytesUsed = samples * 4.
+ * 16 bit stereo is read straight into the chunk; float and mono files
+ * go through a scratch chunk and the chunkOps convert/interleave kernels.
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#include <string.h>
+#include "audioFile.h"
+#include "chunkOps.h"
+#include "zedboard_freertos.h"
+#include "timeStamp.h"
+
+/* read-ahead task */
+static void audioFile_task(void *pArg);
+
+static unsigned int rd16(const unsigned char *p) { return p[0] | (p[1] << 8); }
+static unsigned int rd32(const unsigned char *p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int) p[3] << 24); }
+
+/* Initialize file source */
+int audioFile_init(audioFile_t *pThis, bufferPool_d_t *pBuffP, unsigned int prefetch)
+{
+	if (NULL == pThis || NULL == pBuffP) {
+		printf("[FILE_SRC]: Failed Init\r\n");
+		return -1;
+	}
+
+	memset(pThis, 0, sizeof(*pThis));
+	pThis->pBuffP = pBuffP;
+	pThis->state  = AUDIOFILE_IDLE;
+	audioFile_setPrefetch(pThis, prefetch);
+
+	/* no SD card / file system: file playback fails, live audio runs */
+	if (PASS != fileIo_mount()) {
+		printf("[FILE_SRC]: file playback disabled\r\n");
+	}
+
+	pThis->readyQ = APP_QUEUE_CREATE(pThis, readyQ, AUDIOFILE_PREFETCH_MAX, sizeof(chunk_d_t*));
+	if (0 == pThis->readyQ) {
+		printf("[FILE_SRC]: Failed to create ready queue\r\n");
+		return -1;
+	}
+
+	pThis->task = APP_TASK_CREATE(pThis, task, audioFile_task, "FILE", FILE_TASK_STACK, pThis, FILE_TASK_PRIO);
+	if (NULL == pThis->task) {
+		printf("[FILE_SRC]: Failed to create read-ahead task\r\n");
+		return -1;
+	}
+
+	return PASS;
+}
+
+/* Change prefetch depth */
+void audioFile_setPrefetch(audioFile_t *pThis, unsigned int prefetch)
+{
+	if (prefetch < 1) {
+		prefetch = 1;
+	}
+	if (prefetch > AUDIOFILE_PREFETCH_MAX) {
+		prefetch = AUDIOFILE_PREFETCH_MAX;
+	}
+	pThis->prefetch = prefetch;
+}
+
+/** Parse the RIFF header (if any) and locate the sample data
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure.
+ */
+static int audioFile_parseHeader(audioFile_t *pThis)
+{
+	unsigned char hdr[16];
+	unsigned int offset = 12;
+
+	/* default: headerless 16 bit mono */
+	pThis->channels  = 1;
+	pThis->format    = CHUNK_FMT_S16;
+	pThis->dataStart = 0;
+	pThis->dataBytes = 0xFFFFFFFF;
+
+	if (fileIo_read(&pThis->file, hdr, 12) != 12
+			|| memcmp(hdr, "RIFF", 4) || memcmp(hdr + 8, "WAVE", 4)) {
+		return fileIo_seek(&pThis->file, 0);
+	}
+
+	/* walk the chunks until "data" */
+	while (fileIo_read(&pThis->file, hdr, 8) == 8) {
+		unsigned int size = rd32(hdr + 4);
+		offset += 8;
+
+		if (!memcmp(hdr, "data", 4)) {
+			pThis->dataStart = offset;
+			pThis->dataBytes = size;
+			return PASS;
+		}
+
+		if (!memcmp(hdr, "fmt ", 4)) {
+			if (size < 16 || fileIo_read(&pThis->file, hdr, 16) != 16) {
+				break;
+			}
+			/* 16 bit PCM or 32 bit IEEE float, mono or stereo only */
+			if (rd16(hdr) == 1 && rd16(hdr + 14) == 16) {
+				pThis->format = CHUNK_FMT_S16;
+			} else if (rd16(hdr) == 3 && rd16(hdr + 14) == 32) {
+				pThis->format = CHUNK_FMT_F32;
+			} else {
+				printf("[FILE_SRC]: unsupported WAV format\r\n");
+				return -1;
+			}
+			if (rd16(hdr + 2) < 1 || rd16(hdr + 2) > 2) {
+				printf("[FILE_SRC]: unsupported WAV format\r\n");
+				return -1;
+			}
+			/* no resampler: other rates would play off pitch */
+			if (rd32(hdr + 4) != AUDIO_SAMPLE_RATE) {
+				printf("[FILE_SRC]: %u Hz WAV, need %u Hz\r\n", rd32(hdr + 4), AUDIO_SAMPLE_RATE);
+				return -1;
+			}
+			pThis->channels = rd16(hdr + 2);
+		}
+
+		/* skip rest of the chunk (chunks are word aligned) */
+		offset += size + (size & 1);
+		if (PASS != fileIo_seek(&pThis->file, offset)) {
+			break;
+		}
+	}
+
+	printf("[FILE_SRC]: no data chunk\r\n");
+	return -1;
+}
+
+/* Open a file and start read-ahead */
+int audioFile_start(audioFile_t *pThis, const char *path, int loop)
+{
+	if (AUDIOFILE_IDLE != pThis->state) {
+		printf("[FILE_SRC]: already playing\r\n");
+		return -1;
+	}
+
+	if (PASS != fileIo_open(&pThis->file, path, FILEIO_READ)) {
+		return -1;
+	}
+
+	if (PASS != audioFile_parseHeader(pThis)) {
+		fileIo_close(&pThis->file);
+		return -1;
+	}
+
+	/* not even one frame: nothing to play (and nothing to loop) */
+	if (pThis->dataBytes < pThis->channels * ((CHUNK_FMT_F32 == pThis->format) ? sizeof(float) : sizeof(short))) {
+		printf("[FILE_SRC]: no sample data\r\n");
+		fileIo_close(&pThis->file);
+		return -1;
+	}
+
+	pThis->bytesLeft = pThis->dataBytes;
+	pThis->loop      = loop;
+	pThis->state     = AUDIOFILE_PLAYING;
+
+	xTaskNotifyGive(pThis->task);
+	return PASS;
+}
+
+/* Stop playback */
+void audioFile_stop(audioFile_t *pThis)
+{
+	chunk_d_t *pChunk = NULL;
+
+	/* the read-ahead task leaves its loop, closes the file and ends in EOF */
+	taskENTER_CRITICAL();
+	if (AUDIOFILE_PLAYING == pThis->state) {
+		pThis->state = AUDIOFILE_STOPPING;
+	}
+	taskEXIT_CRITICAL();
+	xTaskNotifyGive(pThis->task);
+	while (AUDIOFILE_STOPPING == pThis->state) {
+		vTaskDelay(1);
+	}
+
+	/* chunks read ahead go back to the pool instead of being played */
+	while (pdTRUE == xQueueReceive(pThis->readyQ, &pChunk, 0)) {
+		bufferPool_d_release(pThis->pBuffP, pChunk);
+	}
+	pThis->state = AUDIOFILE_IDLE;
+}
+
+/* Get the next filled chunk (non blocking) */
+int audioFile_get(audioFile_t *pThis, chunk_d_t **ppChunk)
+{
+	if (pdTRUE != xQueueReceive(pThis->readyQ, ppChunk, 0)) {
+		*ppChunk = NULL;
+		if (AUDIOFILE_EOF == pThis->state) {
+			pThis->state = AUDIOFILE_IDLE;
+		}
+		return -1;
+	}
+
+	/* a slot became free, let the read-ahead task refill it */
+	xTaskNotifyGive(pThis->task);
+	return 1;
+}
+
+/** Fill one chunk from the file
+ *   - 16 bit stereo is read into pChunk as is
+ *   - float is converted and mono interleaved, ping-ponging between
+ *     pTmp and pChunk so that the last step writes pChunk
+ *
+ *@param pChunk  chunk to fill (16 bit stereo)
+ *@param pTmp    scratch chunk, unused for 16 bit stereo files
+ *
+ * @return number of samples put into the chunk, 0 at end of data
+ */
+static int audioFile_fill(audioFile_t *pThis, chunk_d_t *pChunk, chunk_d_t *pTmp)
+{
+	unsigned int sampleBytes = (CHUNK_FMT_F32 == pThis->format) ? sizeof(float) : sizeof(short);
+	unsigned int frames = pChunk->bytesMax / sizeof(unsigned int) / 2;
+	unsigned int bytes  = frames * pThis->channels * sampleBytes;
+	chunk_d_t *pRaw, *pCur;
+	int got;
+
+	if (bytes > pThis->bytesLeft) {
+		bytes = pThis->bytesLeft;
+	}
+
+	/* mono float: raw -> pChunk -> pTmp -> pChunk, other cases take two steps at most */
+	pRaw = ((2 == pThis->channels) == (CHUNK_FMT_S16 == pThis->format)) ? pChunk : pTmp;
+
+	got = fileIo_read(&pThis->file, pRaw->u08_buff, bytes);
+	if (got <= 0) {
+		return 0;
+	}
+	pThis->bytesLeft -= got;
+	frames = got / (pThis->channels * sampleBytes);
+
+	pRaw->format    = pThis->format;
+	pRaw->channels  = pThis->channels;
+	pRaw->bytesUsed = frames * pThis->channels * sizeof(unsigned int);
+	pCur = pRaw;
+
+	/* float to 16 bit, one pass */
+	if (CHUNK_FMT_F32 == pCur->format) {
+		chunk_d_t *pNext = (pCur == pChunk) ? pTmp : pChunk;
+
+		pNext->format = CHUNK_FMT_S16;
+		chunkOps_convert(pNext, pCur, CHUNKOPS_GAIN_UNITY);
+		pCur = pNext;
+	}
+
+	/* mono: same sample into the left and right slot */
+	if (1 == pCur->channels) {
+		chunkOps_interleave(pChunk, pCur, pCur);
+	}
+
+	pChunk->seq       = pThis->seq++;
+	pChunk->tCapture  = timeStamp_get();
+	pChunk->streamId  = CHUNK_STREAM_FILE;
+	return 2 * frames;
+}
+
+/** stream one open file until its end (or forever when looping)
+ *
+ *@param pThis  pointer to audioFile object
+ */
+static void audioFile_stream(audioFile_t *pThis)
+{
+	chunk_d_t *pChunk = NULL;
+	chunk_d_t *pTmp = NULL;
+	unsigned int passChunks = 0;
+
+	/* scratch for conversion, held while the file plays */
+	if (2 != pThis->channels || CHUNK_FMT_S16 != pThis->format) {
+		while (AUDIOFILE_PLAYING == pThis->state && 1 != bufferPool_d_acquire(pThis->pBuffP, &pTmp)) {
+			vTaskDelay(1);
+		}
+	}
+
+	while (AUDIOFILE_PLAYING == pThis->state) {
+
+		/* enough read ahead? wait until the audio task takes a chunk */
+		if (uxQueueMessagesWaiting(pThis->readyQ) >= pThis->prefetch) {
+			ulTaskNotifyTake(pdTRUE, 10);
+			continue;
+		}
+
+		/* pool starved by the audio path - back off and retry */
+		if (1 != bufferPool_d_acquire(pThis->pBuffP, &pChunk)) {
+			vTaskDelay(1);
+			continue;
+		}
+
+		if (0 == audioFile_fill(pThis, pChunk, pTmp)) {
+			bufferPool_d_release(pThis->pBuffP, pChunk);
+
+			/* a pass without a single chunk would loop without ever blocking */
+			if (pThis->loop && 0 != passChunks && PASS == fileIo_seek(&pThis->file, pThis->dataStart)) {
+				pThis->bytesLeft = pThis->dataBytes;
+				passChunks = 0;
+				continue;
+			}
+			break;
+		}
+
+		xQueueSend(pThis->readyQ, &pChunk, portMAX_DELAY);
+		passChunks++;
+	}
+
+	if (NULL != pTmp) {
+		bufferPool_d_release(pThis->pBuffP, pTmp);
+	}
+	fileIo_close(&pThis->file);
+	pThis->state = AUDIOFILE_EOF;
+}
+
+/** read-ahead task: sleeps until a file is started, then streams it
+ *
+ *@param pArg  pointer to audioFile object
+ */
+static void audioFile_task(void *pArg)
+{
+	audioFile_t *pThis = (audioFile_t *) pArg;
+
+	for (;;) {
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+		if (AUDIOFILE_PLAYING == pThis->state) {
+			audioFile_stream(pThis);
+		}
+	}
+}
@@ -0,0 +1,132 @@
+/**
+ *@file audioFile.h
+ *
+ *@brief
+ *  - streaming audio source reading WAV/raw PCM from a file
+ *  - a read-ahead task fills pool chunks ahead of playback so that
+ *    file I/O latency stays off the audio task
+ *  - the read-ahead task is created once at init and sleeps while no
+ *    file is playing
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#ifndef _AUDIO_FILE_H_
+#define _AUDIO_FILE_H_
+
+#include "bufferPool_d.h"
+#include "fileIo.h"
+
+/***************************************************
+            DEFINES
+***************************************************/
+
+/**
+ * @def AUDIOFILE_PREFETCH_DEFAULT
+ * @brief default number of chunks read ahead of playback
+ */
+#define AUDIOFILE_PREFETCH_DEFAULT 4
+
+/**
+ * @def AUDIOFILE_PREFETCH_MAX
+ * @brief upper bound of the prefetch depth (size of the ready queue)
+ */
+#define AUDIOFILE_PREFETCH_MAX 16
+
+/** source states */
+#define AUDIOFILE_IDLE    0 /* no file open */
+#define AUDIOFILE_PLAYING 1 /* read-ahead running */
+#define AUDIOFILE_EOF     2 /* all data read, ready queue draining */
+#define AUDIOFILE_STOPPING 3 /* audioFile_stop() waits for the read-ahead task */
+
+/***************************************************
+            DATA TYPES
+***************************************************/
+
+/** streaming file source object
+ */
+typedef struct {
+  fileIo_t          file;        /* open file */
+  bufferPool_d_t   *pBuffP;      /* pool chunks are taken from */
+  QueueHandle_t     readyQ;      /* chunks filled ahead of playback */
+  TaskHandle_t      task;        /* read-ahead task */
+  unsigned int      prefetch;    /* chunks to keep read ahead */
+  unsigned int      channels;    /* 1 = mono (played on both sides), 2 = stereo */
+  unsigned int      format;      /* CHUNK_FMT_S16 or CHUNK_FMT_F32 samples in the file */
+  unsigned int      dataStart;   /* file offset of first sample */
+  unsigned int      dataBytes;   /* size of sample data */
+  unsigned int      bytesLeft;   /* sample data not yet read */
+  int               loop;        /* restart at end of file */
+  unsigned int      seq;         /* sequence number of the next chunk */
+  volatile int      state;       /* AUDIOFILE_xxx */
+  APP_QUEUE_STORAGE(readyQ, AUDIOFILE_PREFETCH_MAX, sizeof(chunk_d_t*))
+  APP_TASK_STORAGE(task, FILE_TASK_STACK)
+} audioFile_t;
+
+
+/***************************************************
+            Access Methods
+***************************************************/
+
+/** Initialize file source, creates the (idle) read-ahead task
+ *
+ * Parameters:
+ * @param pThis     pointer to own object
+ * @param pBuffP    buffer pool to take chunks from
+ * @param prefetch  number of chunks to read ahead (1..AUDIOFILE_PREFETCH_MAX)
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure.
+ */
+int audioFile_init(audioFile_t *pThis, bufferPool_d_t *pBuffP, unsigned int prefetch);
+
+/** Open a file and wake the read-ahead task
+ *   - RIFF/WAVE files (16 bit PCM or 32 bit float, mono/stereo, at
+ *     AUDIO_SAMPLE_RATE) are parsed,
+ *     anything else is played as raw 16 bit mono PCM
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ * @param path   file to play
+ * @param loop   non-zero to restart at end of file
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure.
+ */
+int audioFile_start(audioFile_t *pThis, const char *path, int loop);
+
+/** Stop playback (looping or not) and return to AUDIOFILE_IDLE
+ *   - waits until the read-ahead task has closed the file, then hands
+ *     the chunks read ahead back to the pool
+ *   - task context, not the audio task (it has to keep calling
+ *     audioFile_get meanwhile)
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ */
+void audioFile_stop(audioFile_t *pThis);
+
+/** Get the next filled chunk (non blocking, for the audio task)
+ *   - caller releases the chunk to the buffer pool
+ *
+ * Parameters:
+ * @param pThis    pointer to own object
+ * @param ppChunk  filled chunk, NULL if none is ready
+ *
+ * @return 1 if a chunk was returned, negative value otherwise
+ */
+int audioFile_get(audioFile_t *pThis, chunk_d_t **ppChunk);
+
+/** Change the prefetch depth while playing
+ *
+ * Parameters:
+ * @param pThis     pointer to own object
+ * @param prefetch  number of chunks to read ahead (1..AUDIOFILE_PREFETCH_MAX)
+ */
+void audioFile_setPrefetch(audioFile_t *pThis, unsigned int prefetch);
+
+#endif
@@ -16,16 +16,80 @@
  *
  *******************************************************************************/
 
+#include <string.h>
 #include "audioPlayer.h"
 #include "zedboard_freertos.h"
 #include "audioRxTx.h"
 
 
-/* number of chunks to allocate */
-#define CHUNK_NUM 30
+/* buffer pool memory shared by all profiles: descriptors and data bytes */
+#define POOL_CHUNKS_MAX 64
+#define POOL_BYTES      (96 * 1024)
 
-/* size of each chunk in bytes */
-#define CHUNK_SIZE 512
+/* largest chunk of any profile (samples) */
+#define CHUNK_SAMPLES_MAX 1024
+
+/* analyzer block lengths in frames: 47 Hz bins for the meters, 23 Hz for DTMF */
+#define ANALYZER_BLOCK 1024
+#define DTMF_BLOCK     2048
+
+/* meter band center frequencies (Hz) */
+static const unsigned int audioPlayer_bandFreqs[METER_BAND_NUM] = {
+	60, 150, 400, 1000, 2500, 5000, 10000, 16000
+};
+
+/* input AGC: speech/music at -18 dBFS RMS, up to +30 dB digital on top of
+ * the startup PGA gain (the default input mixes line in, which has no PGA,
+ * so the PGA stays where the codec init put it) */
+static const agc_config_t audioPlayer_agcDefault = {
+	.targetDb     = -18,
+	.maxGainDb    = 30,
+	.attackMs     = 10,
+	.releaseMs    = 500,
+	.gateDb       = -60,
+	.coarse       = 0,
+	.coarseStepDb = PGA_STEP_DB,
+	.coarseMin    = 0,
+	.coarseMax    = PGA_STEP_MAX,
+	.coarseZero   = PGA_STEP_0DB,
+};
+
+/* chunks the file source reads ahead of playback */
+#define FILE_PREFETCH AUDIOFILE_PREFETCH_DEFAULT
+
+/**
+ * latency profiles: chunk size, pool, queue depth limits and TX prime
+ * depth chosen together. The pool has to cover both queues plus what the
+ * mixer inputs and file read-ahead hold.
+ */
+const audioPlayer_profile_t audioPlayer_profiles[AUDIO_PROFILE_NUM] = {
+	/* name         samples chunks txDepth rxDepth prime */
+	{ "low-latency",    64,    64,      4,      4,    2 },
+	{ "balanced",      256,    48,      8,      8,    2 },
+	{ "efficient",    1024,    24,      4,      4,    1 },
+};
+
+/* sizes that must agree with each other */
+APP_STATIC_ASSERT(AUDIOTX_QUEUE_DEPTH <= POOL_CHUNKS_MAX, tx_queue_not_deeper_than_pool);
+APP_STATIC_ASSERT(AUDIORX_QUEUE_DEPTH <= POOL_CHUNKS_MAX, rx_queue_not_deeper_than_pool);
+APP_STATIC_ASSERT(FILE_PREFETCH <= AUDIOFILE_PREFETCH_MAX, file_prefetch_fits_queue);
+APP_STATIC_ASSERT(AUDIO_TASK_PRIO < configMAX_PRIORITIES, audio_priority_valid);
+
+#if APP_STATIC_ALLOC
+/* buffer pool: chunk descriptors, chunk data and free list storage */
+static chunk_d_t     audioPlayer_chunks[POOL_CHUNKS_MAX];
+static unsigned char audioPlayer_arena[POOL_BYTES] __attribute__ ((aligned (32)));
+static unsigned char audioPlayer_freeList[POOL_CHUNKS_MAX * sizeof(chunk_d_t*)];
+
+/* mixer accumulator and capture ring */
+static int           audioPlayer_mixAcc[CHUNK_SAMPLES_MAX];
+static short         audioPlayer_recRing[RECORDER_RING_SAMPLES(RECORDER_SECONDS, AUDIO_SAMPLE_RATE)];
+#define MIX_ACC  audioPlayer_mixAcc
+#define REC_RING audioPlayer_recRing
+#else
+#define MIX_ACC  NULL
+#define REC_RING NULL
+#endif
 
 /**
  * @def VOLUME_CHANGE_STEP
@@ -42,6 +106,52 @@
  * @brief MIN volume possible is -73db Refer to COCDEC datasheet.
  */
 #define VOLUME_MIN (0x2F)
+/**
+ * @def VOLUME_REG
+ * @brief line out volume register value (R31/R32): volume holds
+ *        LOUTVOL[7:2] and LOMUTE[1] (odd = unmuted), LOMODE[0] set
+ */
+#define VOLUME_REG(volume) ((unsigned short) (((volume) << 1) | 1))
+/** switch the streaming path to a latency profile
+ *   - no chunk of the old geometry may be in use (file source idle)
+ *@param pThis    pointer to the AudioPlayer global instance.
+ *@param profile  AUDIO_PROFILE_xxx
+ *
+ *@return 0 success, non-zero otherwise
+ **/
+static int audioPlayer_applyProfile(audioPlayer_t *pThis, unsigned int profile)
+{
+	const audioPlayer_profile_t *pP = &audioPlayer_profiles[profile];
+
+	/* whole L/R frames, within the mixer accumulator (the FIFO ISRs
+	 * split and merge chunks against the FIFO thresholds themselves) */
+	if (0 != pP->samples % AUDIO_CHANNELS || pP->samples > CHUNK_SAMPLES_MAX) {
+		printf("[AP]: profile %s: invalid chunk size\r\n", pP->name);
+		return FAIL;
+	}
+
+	/* stop the ISRs, take back every chunk, then re-divide the pool */
+	audioRxTx_stop(&pThis->Audio);
+	mixer_flush(&pThis->mixer);
+	if (PASS != bufferPool_d_reinit(&pThis->bp, pP->chunks, pP->samples * sizeof(unsigned int))) {
+		return FAIL;
+	}
+
+	/* queue limits and prime depth, restarts streaming */
+	if (PASS != audioRxTx_configure(&pThis->Audio, pP->txDepth, pP->rxDepth, pP->prime)) {
+		return FAIL;
+	}
+
+	/* deadline: one chunk period (L/R frames, not FIFO slots) */
+	if (PASS != audioWatchdog_init(&pThis->watchdog, pP->samples / AUDIO_CHANNELS, pThis->frequency)) {
+		return FAIL;
+	}
+
+	pThis->profile = profile;
+	printf("[AP]: profile %s, %u samples/chunk\r\n", pP->name, pP->samples);
+	return PASS;
+}
+
 /** initialize audio player 
  *@param pThis  pointer to the AudioPlayer global instance.
  *
@@ -52,13 +162,20 @@ int audioPlayer_init(audioPlayer_t *pThis) {
     printf("[AP]: Init start\r\n");
     
     pThis->volume 		= VOLUME_MIN; /*default volume */
-    pThis->frequency 	= 48000; /* default frequency */
+    pThis->frequency 	= AUDIO_SAMPLE_RATE; /* default frequency */
     
     /* Init I2C/I2S/CODEC and AXI Streaming FIFO */
 	Adau1761_Init(&pThis->codec);
+	AudioPlayer_SetOut_LineVol(&pThis->codec, VOLUME_REG(pThis->volume));
 
 	/* Allocate buffer pool and Init Chunk/freelist*/
-	status = bufferPool_d_init(&pThis->bp, CHUNK_NUM, CHUNK_SIZE);
+	/* (carved up per profile below) */
+#if APP_STATIC_ALLOC
+	status = bufferPool_d_initStatic(&pThis->bp, POOL_CHUNKS_MAX, POOL_BYTES / POOL_CHUNKS_MAX,
+			audioPlayer_chunks, audioPlayer_arena, audioPlayer_freeList);
+#else
+	status = bufferPool_d_init(&pThis->bp, POOL_CHUNKS_MAX, POOL_BYTES / POOL_CHUNKS_MAX);
+#endif
     if ( PASS != status ) {
         return FAIL;
     }
@@ -69,6 +186,60 @@ int audioPlayer_init(audioPlayer_t *pThis) {
         return FAIL;
     }
 
+    /* Mixer for live input + clip/file playback */
+    status = mixer_init(&pThis->mixer, &pThis->bp, MIX_ACC, CHUNK_SAMPLES_MAX);
+    if ( PASS != status) {
+        return FAIL;
+    }
+    pThis->clipActive  = 0;
+    pThis->pendingClip = -1;
+
+    /* Streaming file source (files are opened on demand) */
+    status = audioFile_init(&pThis->file, &pThis->bp, FILE_PREFETCH);
+    if ( PASS != status) {
+        return FAIL;
+    }
+
+    /* Capture ring for RX snapshots (optional, the player runs without it) */
+    recorder_init(&pThis->recorder, REC_RING, RECORDER_SECONDS, AUDIO_SAMPLE_RATE);
+
+    latencyProbe_init(&pThis->latency);
+    memset((void *) pThis->levels, 0, sizeof(pThis->levels));
+
+    /* Goertzel banks: meter bands and DTMF tones */
+    status = goertzel_init(&pThis->bands, audioPlayer_bandFreqs, METER_BAND_NUM,
+    		AUDIO_SAMPLE_RATE, ANALYZER_BLOCK);
+    if ( PASS != status) {
+        return FAIL;
+    }
+    status = goertzel_dtmfInit(&pThis->dtmf, AUDIO_SAMPLE_RATE, DTMF_BLOCK);
+    if ( PASS != status) {
+        return FAIL;
+    }
+    pThis->dtmfLast = 0;
+    pThis->dtmfKey  = 0;
+
+    /* Input level: software AGC from the codec's startup PGA step */
+    pThis->pgaStep = PGA_STEP_DEFAULT;
+    status = agc_init(&pThis->agc, &audioPlayer_agcDefault, pThis->pgaStep, AUDIO_SAMPLE_RATE);
+    if ( PASS != status) {
+        return FAIL;
+    }
+    pThis->agcOn      = 1;
+    pThis->agcPending = -1;
+
+    /* Crossover off until requested */
+    pThis->xoverOn          = 0;
+    pThis->xoverPending     = -1;
+    pThis->xoverBandPending = -1;
+
+    /* Chunk size, pool, queues and deadline of the default profile */
+    pThis->pendingProfile = -1;
+    status = audioPlayer_applyProfile(pThis, AUDIO_PROFILE_DEFAULT);
+    if ( PASS != status) {
+        return FAIL;
+    }
+
     printf("[AP]: Init complete\r\n");
     return PASS;
 }
@@ -83,12 +254,412 @@ int audioPlayer_start(audioPlayer_t *pThis)
 {
     printf("[AP]: startup \r\n");
 	/* Audio Player task creation */
-	xTaskCreate( audioPlayer_task, ( signed char * ) "HW", configMINIMAL_STACK_SIZE, pThis, tskIDLE_PRIORITY + 1 , NULL );
+	APP_TASK_CREATE_LOCAL( audioPlayer_task, "AUDIO", AUDIO_TASK_STACK, pThis, AUDIO_TASK_PRIO );
     return PASS;
 }
 
 
 
+/** play a clip from the sample bank once
+ *@param pThis  pointer to the globally declared and initialized audioPlayer object
+ *@param clip   index into snd_bank[]
+ *
+ *@return 0 success, non-zero otherwise
+ **/
+int audioPlayer_playClip(audioPlayer_t *pThis, unsigned int clip)
+{
+	if (clip >= snd_bank_nClips) {
+		return FAIL;
+	}
+
+	/* the audio task re-points the decoder between two chunks */
+	pThis->pendingClip = clip;
+	return PASS;
+}
+
+/** start a pending clip (audio task, between two chunks)
+ *@param pThis  pointer to the audioPlayer object
+ **/
+static void audioPlayer_applyClip(audioPlayer_t *pThis)
+{
+	unsigned int clip = (unsigned int) pThis->pendingClip;
+
+	pThis->pendingClip = -1;
+	pThis->clipActive  = (PASS == audioSample_initClip(&pThis->clip, &snd_bank[clip]));
+}
+
+/** stream a file
+ *@param pThis  pointer to the globally declared and initialized audioPlayer object
+ *@param path   file to play
+ *@param loop   non-zero to repeat the file
+ *
+ *@return 0 success, non-zero otherwise
+ **/
+int audioPlayer_playFile(audioPlayer_t *pThis, const char *path, int loop)
+{
+	return (PASS == audioFile_start(&pThis->file, path, loop)) ? PASS : FAIL;
+}
+
+/** stop file playback
+ *@param pThis  pointer to the globally declared and initialized audioPlayer object
+ **/
+void audioPlayer_stopFile(audioPlayer_t *pThis)
+{
+	/* the audio task plays out the (at most two) chunks the mixer holds */
+	audioFile_stop(&pThis->file);
+}
+
+/** save the recorder ring as WAV
+ *@param pThis  pointer to the globally declared and initialized audioPlayer object
+ *@param path   file to create
+ *
+ *@return 0 success, non-zero otherwise
+ **/
+int audioPlayer_snapshot(audioPlayer_t *pThis, const char *path)
+{
+	int status = recorder_exportFile(&pThis->recorder, path);
+
+	recorder_resume(&pThis->recorder);
+	printf("[AP]: snapshot %s %s\r\n", path, (PASS == status) ? "saved" : "failed");
+	return (PASS == status) ? PASS : FAIL;
+}
+
+/** set the mix gain of a source
+ *@param pThis  pointer to the globally declared and initialized audioPlayer object
+ *@param input  mixer input
+ *@param gain   Q15 gain
+ **/
+void audioPlayer_setSourceGain(audioPlayer_t *pThis, unsigned int input, short gain)
+{
+	mixer_setGain(&pThis->mixer, input, gain);
+}
+
+/** select a latency profile
+ *@param pThis    pointer to the globally declared and initialized audioPlayer object
+ *@param profile  AUDIO_PROFILE_xxx
+ *
+ *@return 0 success, non-zero otherwise
+ **/
+int audioPlayer_setProfile(audioPlayer_t *pThis, unsigned int profile)
+{
+	if (profile >= AUDIO_PROFILE_NUM) {
+		return FAIL;
+	}
+	if (AUDIOFILE_IDLE != pThis->file.state) {
+		printf("[AP]: stop file playback before changing the profile\r\n");
+		return FAIL;
+	}
+
+	/* the audio task applies it between two chunks */
+	pThis->pendingProfile = profile;
+	return PASS;
+}
+
+/** measure the round trip latency
+ *@param pThis  pointer to the globally declared and initialized audioPlayer object
+ **/
+void audioPlayer_measureLatency(audioPlayer_t *pThis)
+{
+	latencyProbe_start(&pThis->latency);
+}
+
+/** print the result of the last latency measurement
+ *@param pThis  pointer to the globally declared and initialized audioPlayer object
+ *
+ *@return 0 success, non-zero otherwise
+ **/
+int audioPlayer_latencyReport(audioPlayer_t *pThis)
+{
+	return (PASS == latencyProbe_report(&pThis->latency, pThis->frequency)) ? PASS : FAIL;
+}
+
+/** change the line out volume
+ *@param pThis  pointer to the globally declared and initialized audioPlayer object
+ *@param steps  volume steps (VOLUME_CHANGE_STEP each), negative to decrease
+ **/
+void audioPlayer_volumeStep(audioPlayer_t *pThis, int steps)
+{
+	int volume = pThis->volume + steps * VOLUME_CHANGE_STEP;
+
+	if (volume > VOLUME_MAX) {
+		volume = VOLUME_MAX;
+	} else if (volume < VOLUME_MIN) {
+		volume = VOLUME_MIN;
+	}
+	if (volume == pThis->volume) {
+		return;
+	}
+
+	pThis->volume = volume;
+	AudioPlayer_SetOut_LineVol(&pThis->codec, VOLUME_REG(volume));
+}
+
+/** increase audio volume by one step
+ *@param pThis  pointer to the globally declared and initialized audioPlayer object
+ **/
+void audioPlayer_volumeIncrease(audioPlayer_t *pThis)
+{
+	audioPlayer_volumeStep(pThis, 1);
+}
+
+/** decrease audio volume by one step
+ *@param pThis  pointer to the globally declared and initialized audioPlayer object
+ **/
+void audioPlayer_volumeDecrease(audioPlayer_t *pThis)
+{
+	audioPlayer_volumeStep(pThis, -1);
+}
+
+/** read and reset the band levels for the meters
+ *@param pThis    pointer to the globally declared and initialized audioPlayer object
+ *@param pLevels  METER_BAND_NUM magnitudes
+ **/
+void audioPlayer_getLevels(audioPlayer_t *pThis, uint32_t *pLevels)
+{
+	unsigned int i;
+
+	/* the audio task raises levels[] between two reads */
+	taskENTER_CRITICAL();
+	for (i = 0; i < METER_BAND_NUM; i++) {
+		pLevels[i] = pThis->levels[i];
+		pThis->levels[i] = 0;
+	}
+	taskEXIT_CRITICAL();
+}
+
+/** read the last DTMF key received on the live input
+ *@param pThis  pointer to the globally declared and initialized audioPlayer object
+ *
+ *@return key, 0 if none since the last call
+ **/
+char audioPlayer_getDtmf(audioPlayer_t *pThis)
+{
+	char key = pThis->dtmfKey;
+
+	pThis->dtmfKey = 0;
+	return key;
+}
+
+/** enable or disable the output crossover
+ *@param pThis   pointer to the globally declared and initialized audioPlayer object
+ *@param ways    number of bands, 0 to disable
+ *@param pFreqs  split frequencies in Hz, ascending
+ *
+ *@return 0 success, non-zero otherwise
+ **/
+int audioPlayer_setCrossover(audioPlayer_t *pThis, unsigned int ways, const unsigned int *pFreqs)
+{
+	unsigned int i;
+
+	if (0 != ways && (ways < CROSSOVER_WAYS_MIN || ways > CROSSOVER_WAYS_MAX)) {
+		return FAIL;
+	}
+	if (pThis->xoverPending >= 0 || pThis->xoverBandPending >= 0) {
+		printf("[AP]: crossover change in progress\r\n");
+		return FAIL;
+	}
+	if (0 == ways) {
+		pThis->xoverPending = 0;
+		return PASS;
+	}
+
+	/* the audio task designs the filters between two chunks */
+	for (i = 0; i < ways - 1; i++) {
+		pThis->xoverFreqs[i] = pFreqs[i];
+	}
+	pThis->xoverPending = ways;
+	return PASS;
+}
+
+/** route and delay one crossover band
+ *@param pThis    pointer to the globally declared and initialized audioPlayer object
+ *@param band     band index
+ *@param outMask  CROSSOVER_OUT_xxx
+ *@param delayUs  band delay in microseconds
+ *
+ *@return 0 success, non-zero otherwise
+ **/
+int audioPlayer_setCrossoverBand(audioPlayer_t *pThis, unsigned int band, unsigned int outMask,
+		unsigned int delayUs)
+{
+	if (pThis->xoverPending >= 0 || pThis->xoverBandPending >= 0) {
+		printf("[AP]: crossover change in progress\r\n");
+		return FAIL;
+	}
+	if (!pThis->xoverOn || band >= pThis->xover.ways) {
+		return FAIL;
+	}
+
+	/* the audio task changes the band between two chunks */
+	pThis->xoverBandMask    = outMask;
+	pThis->xoverBandDelayUs = delayUs;
+	pThis->xoverBandPending = band;
+	return PASS;
+}
+
+/** apply a pending crossover request (audio task, between two chunks)
+ *@param pThis  pointer to the audioPlayer object
+ **/
+static void audioPlayer_applyCrossover(audioPlayer_t *pThis)
+{
+	unsigned int ways = (unsigned int) pThis->xoverPending;
+
+	pThis->xoverOn = 0;
+	if (ways && PASS == crossover_init(&pThis->xover, ways, pThis->xoverFreqs, pThis->frequency)) {
+		pThis->xoverOn = 1;
+		printf("[AP]: crossover %u ways, low band /%u\r\n", ways, 1u << pThis->xover.stages);
+	}
+	pThis->xoverPending = -1;
+}
+
+/** apply a pending crossover band request (audio task, between two chunks)
+ *@param pThis  pointer to the audioPlayer object
+ **/
+static void audioPlayer_applyCrossoverBand(audioPlayer_t *pThis)
+{
+	if (pThis->xoverOn) {
+		crossover_setBand(&pThis->xover, (unsigned int) pThis->xoverBandPending,
+				pThis->xoverBandMask, pThis->xoverBandDelayUs);
+	}
+	pThis->xoverBandPending = -1;
+}
+
+/** change the input AGC settings
+ *@param pThis  pointer to the globally declared and initialized audioPlayer object
+ *@param pCfg   settings, NULL to disable
+ *
+ *@return 0 success, non-zero otherwise
+ **/
+int audioPlayer_setAgc(audioPlayer_t *pThis, const agc_config_t *pCfg)
+{
+	if (pThis->agcPending >= 0) {
+		printf("[AP]: AGC change in progress\r\n");
+		return FAIL;
+	}
+
+	/* the audio task re-initializes the AGC between two chunks */
+	if (NULL == pCfg) {
+		pThis->agcPending = 0;
+		return PASS;
+	}
+	pThis->agcConfig  = *pCfg;
+	pThis->agcPending = 1;
+	return PASS;
+}
+
+/** apply a pending AGC request (audio task, between two chunks)
+ *@param pThis  pointer to the audioPlayer object
+ **/
+static void audioPlayer_applyAgc(audioPlayer_t *pThis)
+{
+	/* the GPIO task is writing a coarse step - re-init after it reported
+	 * it (pgaStep is current then), only this task raises new requests */
+	if (AGC_COARSE_NONE != agc_coarsePending(&pThis->agc)) {
+		return;
+	}
+
+	pThis->agcOn = 0;
+	if (pThis->agcPending
+			&& PASS == agc_init(&pThis->agc, &pThis->agcConfig, pThis->pgaStep, pThis->frequency)) {
+		pThis->agcOn = 1;
+	}
+	pThis->agcPending = -1;
+}
+
+/** write the input PGA step requested by the AGC to the codec
+ *@param pThis  pointer to the globally declared and initialized audioPlayer object
+ **/
+void audioPlayer_agcService(audioPlayer_t *pThis)
+{
+	int step = agc_coarsePending(&pThis->agc);
+
+	if (AGC_COARSE_NONE == step) {
+		return;
+	}
+
+	Adau1761_SetIn_PgaVol(&pThis->codec, PGA_VOL_REG(step), PGA_VOL_REG(step));
+	pThis->pgaStep = step;
+	agc_coarseDone(&pThis->agc, step);
+}
+
+/** band levels of the output, raised into levels[] per analyzer block
+ *@param pThis  pointer to the audioPlayer object
+ *@param pOut   output chunk
+ **/
+static void audioPlayer_analyze(audioPlayer_t *pThis, const chunk_d_t *pOut)
+{
+	uint32_t mag[METER_BAND_NUM];
+	unsigned int i;
+
+	if (0 == goertzel_process(&pThis->bands, pOut)) {
+		return;
+	}
+
+	/* sine amplitude (32768 full scale) -> meter input */
+	for (i = 0; i < METER_BAND_NUM; i++) {
+		mag[i] = 2 * goertzel_amplitude(&pThis->bands, i);
+		if (mag[i] > METER_IN_FULL) {
+			mag[i] = METER_IN_FULL;
+		}
+	}
+
+	taskENTER_CRITICAL();
+	for (i = 0; i < METER_BAND_NUM; i++) {
+		if (mag[i] > pThis->levels[i]) {
+			pThis->levels[i] = mag[i];
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+
+/** DTMF keys on the live input, reported on the first block of a press
+ *@param pThis   pointer to the audioPlayer object
+ *@param pChunk  RX chunk
+ **/
+static void audioPlayer_detectDtmf(audioPlayer_t *pThis, const chunk_d_t *pChunk)
+{
+	char key;
+
+	if (0 == goertzel_process(&pThis->dtmf, pChunk)) {
+		return;
+	}
+
+	key = goertzel_dtmfKey(&pThis->dtmf);
+	if (key && key != pThis->dtmfLast) {
+		pThis->dtmfKey = key;
+	}
+	pThis->dtmfLast = key;
+}
+
+/** feed clip and file sources into the mixer for the next output chunk
+ *@param pThis    pointer to the audioPlayer object
+ *@param samples  length of the next output chunk
+ **/
+static void audioPlayer_feedSources(audioPlayer_t *pThis, unsigned int samples)
+{
+	chunk_d_t *pChunk = NULL;
+
+	/* clip: decode exactly one output chunk worth */
+	if (pThis->clipActive && 1 == bufferPool_d_acquire(&pThis->bp, &pChunk)) {
+		if (pChunk->bytesMax > (int) (samples * sizeof(unsigned int))) {
+			pChunk->bytesMax = samples * sizeof(unsigned int);
+		}
+		audioSample_get(&pThis->clip, pChunk);
+		mixer_submit(&pThis->mixer, MIXER_IN_CLIP, pChunk);
+
+		/* clip wrapped around - played once, stop */
+		if (0 == pThis->clip.count) {
+			pThis->clipActive = 0;
+		}
+	}
+
+	/* file: keep two chunks queued, the read-ahead task has more */
+	while (mixer_queued(&pThis->mixer, MIXER_IN_FILE) < 2
+			&& 1 == audioFile_get(&pThis->file, &pChunk)) {
+		mixer_submit(&pThis->mixer, MIXER_IN_FILE, pChunk);
+	}
+}
+
 /** main loop of audio player does not terminate
  *@param pThis  pointer to the globally declared and initialized audioPlayer object
  *
@@ -102,6 +673,9 @@ void audioPlayer_task (void *pArg) {
 	int status = FAIL;
 	audioPlayer_t *pThis = (audioPlayer_t *)  pArg;
 	chunk_d_t *pChunk = NULL;
+	chunk_d_t *pOut = NULL;
+	unsigned int samples;
+	latencyProbe_path_t path;
 
     /* Start the audio module (FIFO Interrupt Enable)*/
     status = audioRxTx_start(&pThis->Audio);
@@ -114,8 +688,86 @@ void audioPlayer_task (void *pArg) {
 	{
     		/** Get Audio Chunk */
 			audioRxTx_get(&pThis->Audio, &pChunk);
+			audioWatchdog_begin(&pThis->watchdog);
+			samples = pChunk->bytesUsed / sizeof(unsigned int);
+			latencyProbe_rx(&pThis->latency, pChunk);
+
+			/* no frames dropped from the TX path while a marker is in flight */
+			pThis->Audio.jitter.enabled = (LATENCY_ARMED != pThis->latency.state
+					&& LATENCY_WAITING != pThis->latency.state);
+
+			/* input level (before it is recorded, analyzed and mixed) */
+			if (pThis->agcOn) {
+				agc_process(&pThis->agc, pChunk);
+			}
+
+			/* retain RX audio for snapshots (optional stage) */
+			if (audioWatchdog_enabled(&pThis->watchdog, AUDIOWD_STAGE_RECORDER)) {
+				recorder_put(&pThis->recorder, pChunk);
+			}
+
+			/* control tones (before the chunk goes to the mixer) */
+			audioPlayer_detectDtmf(pThis, pChunk);
+
+			/* no chunk for the mix - pass the live input through */
+			if (1 != bufferPool_d_acquire(&pThis->bp, &pOut)) {
+				audioRxTx_put(&pThis->Audio, pChunk);
+				audioWatchdog_end(&pThis->watchdog);
+				continue;
+			}
+
+			/* output keeps the timing of the RX chunk it is made from */
+			chunk_d_copyMeta(pChunk, pOut);
+			pOut->streamId = CHUNK_STREAM_MIX;
+
+			/* Mix live input with clip/file playback */
+			mixer_submit(&pThis->mixer, MIXER_IN_LIVE, pChunk);
+			audioPlayer_feedSources(pThis, samples);
+			mixer_process(&pThis->mixer, pOut, samples);
+
+			/* meter bands of what is played (optional stage) */
+			if (audioWatchdog_enabled(&pThis->watchdog, AUDIOWD_STAGE_ANALYZER)) {
+				audioPlayer_analyze(pThis, pOut);
+			}
+
+			/* split into bands onto the line outs */
+			if (pThis->xoverOn && PASS != crossover_process(&pThis->xover, pOut)) {
+				/* never put the full range mix on a band output */
+				memset(pOut->u08_buff, 0, pOut->bytesUsed);
+			}
+
+			/* latency marker / mute while measuring */
+			if (LATENCY_ARMED == pThis->latency.state || LATENCY_WAITING == pThis->latency.state) {
+				audioRxTx_getPath(&pThis->Audio, samples, &path);
+				latencyProbe_tx(&pThis->latency, pOut, &path);
+			}
+
+			/* Transmit the mixed chunk */
+			audioRxTx_put(&pThis->Audio, pOut);
+			audioWatchdog_end(&pThis->watchdog);
+
+			/* clip requested */
+			if (pThis->pendingClip >= 0) {
+				audioPlayer_applyClip(pThis);
+			}
+
+			/* profile change requested (file source must be idle) */
+			if (pThis->pendingProfile >= 0 && AUDIOFILE_IDLE == pThis->file.state) {
+				audioPlayer_applyProfile(pThis, pThis->pendingProfile);
+				pThis->pendingProfile = -1;
+			}
+
+			/* AGC settings changed */
+			if (pThis->agcPending >= 0) {
+				audioPlayer_applyAgc(pThis);
+			}
 
-			/* Transmit the data that was received from the RX Queue */
-			audioRxTx_put(&pThis->Audio, pChunk);
+			/* crossover change requested */
+			if (pThis->xoverPending >= 0) {
+				audioPlayer_applyCrossover(pThis);
+			}
+			if (pThis->xoverBandPending >= 0) {
+				audioPlayer_applyCrossoverBand(pThis);
+			}
         }
 	}
@@ -21,6 +21,34 @@
 #include "bufferPool_d.h"
 #include "audioRxTx.h"
 #include "adau1761.h"
+#include "mixer.h"
+#include "audioSample.h"
+#include "audioFile.h"
+#include "recorder.h"
+#include "audioWatchdog.h"
+#include "meter.h"
+#include "goertzel.h"
+#include "crossover.h"
+#include "agc.h"
+
+/** latency profiles (index into audioPlayer_profiles[]) */
+#define AUDIO_PROFILE_LOW       0  /* 64 samples/chunk, live monitoring */
+#define AUDIO_PROFILE_BALANCED  1  /* 256 samples/chunk */
+#define AUDIO_PROFILE_EFFICIENT 2  /* 1024 samples/chunk, fewest interrupts */
+#define AUDIO_PROFILE_NUM       3
+#define AUDIO_PROFILE_DEFAULT   AUDIO_PROFILE_BALANCED
+
+/** latency profile: streaming geometry chosen as a whole */
+typedef struct {
+  const char   *name;
+  unsigned int  samples;   /* samples per chunk (FIFO slots, L,R interleaved) */
+  unsigned int  chunks;    /* chunks in the buffer pool */
+  unsigned int  txDepth;   /* TX queue depth limit */
+  unsigned int  rxDepth;   /* RX queue depth limit */
+  unsigned int  prime;     /* chunks primed into the TX FIFO */
+} audioPlayer_profile_t;
+
+extern const audioPlayer_profile_t audioPlayer_profiles[AUDIO_PROFILE_NUM];
 
 /** audioPlayer object **/
 typedef struct {
@@ -30,6 +58,33 @@ typedef struct {
   unsigned int 		frequency;	/* Frequency of the audio player */
   chunk_d_t         *chunk;  /* Chunk for copy */
   tAdau1761 		codec;  /* audio codec */
+  mixer_t			mixer;	/* combines live input, clip and file playback */
+  audioSample_t		clip;	/* sample bank clip player */
+  int				clipActive;	/* clip is being played (audio task only) */
+  volatile int		pendingClip;	/* clip to start, -1 if none */
+  audioFile_t		file;	/* streamed file source */
+  recorder_t		recorder;	/* keeps the last seconds of RX audio */
+  audioWatchdog_t	watchdog;	/* chunk deadline, sheds optional stages */
+  latencyProbe_t	latency;	/* round trip measurement */
+  unsigned int		profile;	/* active latency profile */
+  volatile int		pendingProfile;	/* profile to switch to, -1 if none */
+  volatile uint32_t	levels[METER_BAND_NUM];	/* analyzer band magnitudes, max since last read */
+  goertzel_t		bands;	/* meter band analyzer on the output */
+  goertzel_t		dtmf;	/* DTMF detector on the live input */
+  char				dtmfLast;	/* key of the previous DTMF block */
+  volatile char		dtmfKey;	/* key pressed, 0 once read */
+  crossover_t		xover;	/* band split of the output onto L/R */
+  volatile int		xoverOn;	/* crossover applied to the output */
+  volatile int		xoverPending;	/* band count to switch to, -1 if none */
+  unsigned int		xoverFreqs[CROSSOVER_WAYS_MAX - 1];	/* split frequencies of the request */
+  volatile int		xoverBandPending;	/* band to re-route, -1 if none */
+  unsigned int		xoverBandMask;	/* CROSSOVER_OUT_xxx of the band request */
+  unsigned int		xoverBandDelayUs;	/* delay of the band request */
+  agc_t				agc;	/* input level control (codec ALC is off) */
+  volatile int		agcOn;	/* AGC applied to the live input */
+  volatile int		agcPending;	/* 1: apply agcConfig, 0: disable, -1 if none */
+  agc_config_t		agcConfig;	/* settings of the request */
+  volatile int		pgaStep;	/* input PGA step set in the codec */
 } audioPlayer_t;
 
 /** initialize audio player 
@@ -51,6 +106,142 @@ void audioPlayer_volumeIncrease(audioPlayer_t *pThis);
  **/
 void audioPlayer_volumeDecrease(audioPlayer_t *pThis);
 
+/** change audio volume by several steps (clamped to the codec range)
+ *@param pThis  pointer to own object
+ *@param steps  number of steps, negative to decrease
+ *
+ **/
+void audioPlayer_volumeStep(audioPlayer_t *pThis, int steps);
+
+/** play a clip from the sample bank once, mixed over the live input
+ *   - started by the audio task between two chunks (restarts a clip
+ *     that is playing)
+ *@param pThis  pointer to own object
+ *@param clip   index into snd_bank[]
+ *
+ *@return 0 success, non-zero otherwise
+ **/
+int audioPlayer_playClip(audioPlayer_t *pThis, unsigned int clip);
+
+/** stream a WAV/raw file, mixed over the live input
+ *@param pThis  pointer to own object
+ *@param path   file to play
+ *@param loop   non-zero to repeat the file
+ *
+ *@return 0 success, non-zero otherwise
+ **/
+int audioPlayer_playFile(audioPlayer_t *pThis, const char *path, int loop);
+
+/** stop file playback (also a looping one)
+ *   - returns once the file is closed and the read-ahead chunks are back
+ *     in the pool, the file source is idle then
+ *@param pThis  pointer to own object
+ **/
+void audioPlayer_stopFile(audioPlayer_t *pThis);
+
+/** save the recorder ring (last RECORDER_SECONDS of RX audio) as WAV
+ *   - the ring is frozen during the export, capture resumes afterwards
+ *   - needs a file system (FILEIO_FATFS), fails otherwise
+ *   - blocks for the file write, call from the GPIO task
+ *@param pThis  pointer to own object
+ *@param path   file to create
+ *
+ *@return 0 success, non-zero otherwise
+ **/
+int audioPlayer_snapshot(audioPlayer_t *pThis, const char *path);
+
+/** set the mix gain of a source
+ *@param pThis  pointer to own object
+ *@param input  MIXER_IN_LIVE, MIXER_IN_CLIP or MIXER_IN_FILE
+ *@param gain   Q15 gain (MIXER_GAIN_UNITY = 0 dB)
+ **/
+void audioPlayer_setSourceGain(audioPlayer_t *pThis, unsigned int input, short gain);
+
+/** measure the round trip latency (needs line out looped back to line in)
+ *   - the output is muted until the marker comes back (or 1 s timeout)
+ *@param pThis  pointer to own object
+ **/
+void audioPlayer_measureLatency(audioPlayer_t *pThis);
+
+/** print the result of the last latency measurement
+ *@param pThis  pointer to own object
+ *
+ *@return 0 success, non-zero if no result is available
+ **/
+int audioPlayer_latencyReport(audioPlayer_t *pThis);
+
+/** select a latency profile
+ *   - applied by the audio task between two chunks: streaming stops,
+ *     pool, queues and deadline are re-initialized, streaming restarts
+ *   - file playback has to be stopped (chunks are re-divided), see
+ *     audioPlayer_stopFile()
+ *@param pThis    pointer to own object
+ *@param profile  AUDIO_PROFILE_xxx
+ *
+ *@return 0 success, non-zero otherwise
+ **/
+int audioPlayer_setProfile(audioPlayer_t *pThis, unsigned int profile);
+
+/** read the band levels for the meters
+ *   - largest magnitude per band since the previous call (0..METER_IN_FULL),
+ *     so short peaks between two display frames are not lost
+ *@param pThis    pointer to own object
+ *@param pLevels  METER_BAND_NUM magnitudes
+ **/
+void audioPlayer_getLevels(audioPlayer_t *pThis, uint32_t *pLevels);
+
+/** read the last DTMF key received on the live input
+ *   - a key is reported once per press
+ *@param pThis  pointer to own object
+ *
+ *@return key ('0'-'9', '*', '#', 'A'-'D'), 0 if none since the last call
+ **/
+char audioPlayer_getDtmf(audioPlayer_t *pThis);
+
+/** enable or disable the output crossover
+ *   - the mix (L+R) is split into bands, by default the lowest band is
+ *     played on the left line out, the others on the right (bi-amp)
+ *   - applied by the audio task between two chunks
+ *@param pThis   pointer to own object
+ *@param ways    number of bands (CROSSOVER_WAYS_MIN..MAX), 0 to disable
+ *@param pFreqs  ways - 1 split frequencies in Hz, ascending
+ *
+ *@return 0 success, non-zero otherwise
+ **/
+int audioPlayer_setCrossover(audioPlayer_t *pThis, unsigned int ways, const unsigned int *pFreqs);
+
+/** route and delay one crossover band (after audioPlayer_setCrossover())
+ *   - applied by the audio task between two chunks
+ *@param pThis    pointer to own object
+ *@param band     band index, 0 = lowest
+ *@param outMask  CROSSOVER_OUT_L and/or CROSSOVER_OUT_R, 0 = muted
+ *@param delayUs  band delay in microseconds (driver alignment)
+ *
+ *@return 0 success, non-zero otherwise
+ **/
+int audioPlayer_setCrossoverBand(audioPlayer_t *pThis, unsigned int band, unsigned int outMask,
+		unsigned int delayUs);
+
+/** change the input AGC settings
+ *   - applied by the audio task between two chunks, the level estimate
+ *     starts over at unity fine gain
+ *   - with pCfg->coarse set the input PGA is moved as well (mic input only,
+ *     the line input has no PGA); coarseStepDb/Min/Max/Zero describe the
+ *     PGA (PGA_STEP_xxx)
+ *@param pThis  pointer to own object
+ *@param pCfg   settings, NULL to disable (the PGA keeps its step)
+ *
+ *@return 0 success, non-zero otherwise
+ **/
+int audioPlayer_setAgc(audioPlayer_t *pThis, const agc_config_t *pCfg);
+
+/** write the input PGA step requested by the AGC to the codec
+ *   - I2C access, called periodically from the GPIO task, next to its
+ *     volume writes (the I2C driver has no lock)
+ *@param pThis  pointer to own object
+ **/
+void audioPlayer_agcService(audioPlayer_t *pThis);
+
 /** startup phase after initialization 
  *@param pThis  pointer to own object 
  *
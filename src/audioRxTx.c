@@ -15,8 +15,10 @@
  * $Id: audioRxTx.c 1009 2016-04-03 20:00:02Z surya2891 $
  *
  *******************************************************************************/
+#include <string.h>
 #include "audioRxTx.h"
 #include "bufferPool_d.h"
+#include "timeStamp.h"
 
 
 /* Init RX/TX Queue */
@@ -28,19 +30,71 @@ int audioRxTx_init(audioRxTx_t *pThis, bufferPool_d_t *pBuffP)
     }
 
     pThis->pPending     = NULL;
+    pThis->pTxPending   = NULL;
+    pThis->txOffset     = 0;
     pThis->pBuffP       = pBuffP;
 
-    pThis->running      = 0;    // Disable ISR mode - first chunk to be sent to FIFO by polling.
+    pThis->running      = 0;    // TX ISR off until the FIFO is primed
     //Create Tx_Queue
-    pThis->tx_queue = xQueueCreate(AUDIOTX_QUEUE_DEPTH, sizeof(chunk_d_t*));
+    pThis->tx_queue = APP_QUEUE_CREATE(pThis, tx_queue, AUDIOTX_QUEUE_DEPTH, sizeof(chunk_d_t*));
     //Create RX_Queue.
-    pThis->rx_queue = xQueueCreate(AUDIORX_QUEUE_DEPTH, sizeof(chunk_d_t*));
+    pThis->rx_queue = APP_QUEUE_CREATE(pThis, rx_queue, AUDIORX_QUEUE_DEPTH, sizeof(chunk_d_t*));
+    //TX FIFO is empty after codec init - vacancy is its depth
+    pThis->txFifoDepth = *(volatile u32 *) (FIFO_BASE_ADDR + FIFO_TX_VAC);
+    //Full queue capacity until a profile is configured
+    pThis->txDepth      = AUDIOTX_QUEUE_DEPTH;
+    pThis->rxDepth      = AUDIORX_QUEUE_DEPTH;
+    pThis->primeChunks  = AUDIOTX_PRIME_CHUNKS;
+    memset(&pThis->seq, 0, sizeof(pThis->seq));
+    //TX queue latency control
+    jitterCtl_init(&pThis->jitter, JITTER_MARGIN);
     printf("[A_RX/TX]: Init complete\r\r\n");
 
     return PASS;
 }
 
 
+/* Stop streaming */
+void audioRxTx_stop(audioRxTx_t *pThis)
+{
+	/* stop both ISR paths */
+	taskENTER_CRITICAL();
+	*(volatile u32 *) (FIFO_BASE_ADDR + FIFO_INT_ENABLE) = 0x0;
+	pThis->running = 0;
+	taskEXIT_CRITICAL();
+
+	/* drop stale samples and chunks */
+	*(volatile u32 *) (FIFO_BASE_ADDR + FIFO_TX_RESET) = FIFO_TX_RESET_VALUE;
+	*(volatile u32 *) (FIFO_BASE_ADDR + FIFO_RX_RESET) = FIFO_RX_RESET_VALUE;
+	xQueueReset(pThis->tx_queue);
+	xQueueReset(pThis->rx_queue);
+	pThis->pPending   = NULL;
+	pThis->pTxPending = NULL;
+	pThis->seq.txSeqValid = 0; /* chunks in flight were dropped on purpose */
+}
+
+/* Reconfigure queues and FIFOs */
+int audioRxTx_configure(audioRxTx_t *pThis, unsigned int txDepth, unsigned int rxDepth, unsigned int primeChunks)
+{
+	if (txDepth < 1 || txDepth > AUDIOTX_QUEUE_DEPTH || rxDepth < 1 || rxDepth > AUDIORX_QUEUE_DEPTH
+			|| primeChunks < 1 || primeChunks > txDepth) {
+		printf("[A_RX/TX]: invalid configuration\r\n");
+		return -1;
+	}
+
+	audioRxTx_stop(pThis);
+
+	pThis->txDepth     = txDepth;
+	pThis->rxDepth     = rxDepth;
+	pThis->primeChunks = primeChunks;
+	jitterCtl_init(&pThis->jitter, JITTER_MARGIN);
+
+	/* RX restarts right away, TX once primed */
+	*(volatile u32 *) (FIFO_BASE_ADDR + FIFO_INT_STATUS) = 0xffffffff;
+	*(volatile u32 *) (FIFO_BASE_ADDR + FIFO_INT_ENABLE) = FIFO_INT_RFPF;
+	return PASS;
+}
+
 /* Init FIFO interrupt */
 int audioRxTx_start(audioRxTx_t *pThis)
 {
@@ -86,8 +140,125 @@ int audioRxTx_get(audioRxTx_t *pThis, chunk_d_t **pChunk)
     return 0;
 }
 
-/** Audio ISR (FIFO)
+/* Samples buffered along the path */
+void audioRxTx_getPath(audioRxTx_t *pThis, unsigned int chunkSamples, latencyProbe_path_t *pPath)
+{
+	chunk_d_t *pRx, *pTx;
+
+	/* chunks the ISR is filling / emptying count as FIFO fill */
+	taskENTER_CRITICAL();
+	pRx = pThis->pPending;
+	pTx = pThis->pTxPending;
+	pPath->fifoRx  = *(volatile u32 *) (FIFO_BASE_ADDR + FIFO_RX_OCC)
+			+ ((NULL != pRx) ? pRx->bytesUsed / sizeof(unsigned int) : 0);
+	pPath->fifoTx  = pThis->txFifoDepth - *(volatile u32 *) (FIFO_BASE_ADDR + FIFO_TX_VAC)
+			+ ((NULL != pTx) ? pTx->bytesUsed / sizeof(unsigned int) - pThis->txOffset : 0);
+	taskEXIT_CRITICAL();
+	pPath->rxQueue = uxQueueMessagesWaiting(pThis->rx_queue) * chunkSamples;
+	pPath->process = chunkSamples;
+	pPath->txQueue = uxQueueMessagesWaiting(pThis->tx_queue) * chunkSamples;
+}
+
+/** check sequence and latency of a chunk written to the TX FIFO
+ *   (ISR and task context, no OS calls)
+ * Parameters:
+ * @param pThis   pointer to own object
+ * @param pChunk  chunk about to be released
+ */
+static void audioRxTx_txAccount(audioRxTx_t *pThis, const chunk_d_t *pChunk)
+{
+	audioRxTx_seqStats_t *pS = &pThis->seq;
+
+	if (CHUNK_STREAM_RX != pChunk->streamId && CHUNK_STREAM_MIX != pChunk->streamId) {
+		return;
+	}
+
+	pS->txLatency = timeStamp_get() - pChunk->tCapture;
+	if (pS->txLatency > pS->txLatencyMax) {
+		pS->txLatencyMax = pS->txLatency;
+	}
+
+	if (pS->txSeqValid) {
+		int step = (int) (pChunk->seq - pS->txLastSeq);
+		if (step <= 0) {
+			pS->txReorders++;
+			return;
+		}
+		pS->txGaps += step - 1;
+	}
+	pS->txLastSeq  = pChunk->seq;
+	pS->txSeqValid = 1;
+}
+
+/** write queued audio into the TX FIFO
+ *   - the rest of a partly written chunk first, then chunks from the
+ *     queue; a chunk larger than the vacancy is finished on the next call
+ *   - TX side only: ISR, or task context with TFPE masked
+ * Parameters:
+ * @param pThis    pointer to own object
+ * @param quota    slots to write at most
+ * @param fromIsr  non-zero in ISR context
  *
+ * @return slots written
+ */
+static unsigned int audioRxTx_txFill(audioRxTx_t *pThis, unsigned int quota, int fromIsr)
+{
+	unsigned int vacancy = *(volatile u32 *) (FIFO_BASE_ADDR + FIFO_TX_VAC);
+	unsigned int written = 0;
+	unsigned int samplesInChunk, n;
+	chunk_d_t *pChunk;
+
+	while (quota && vacancy) {
+		if (NULL == pThis->pTxPending) {
+			if (pdTRUE != (fromIsr ? xQueueReceiveFromISR(pThis->tx_queue, &pThis->pTxPending, NULL)
+					: xQueueReceive(pThis->tx_queue, &pThis->pTxPending, 0))) {
+				pThis->pTxPending = NULL;
+				break;
+			}
+			pThis->txOffset = 0;
+		}
+		pChunk = pThis->pTxPending;
+
+		/* how many samples does the chunk still contain ? */
+		samplesInChunk = pChunk->bytesUsed/sizeof(unsigned int) - pThis->txOffset;
+		n = samplesInChunk;
+		if (n > quota) {
+			n = quota;
+		}
+		if (n > vacancy) {
+			n = vacancy;
+		}
+
+		/* Transmit the chunk data to the TX FIFO */
+		for (samplesInChunk = 0; samplesInChunk < n; samplesInChunk++) {
+			*(volatile u32 *) (FIFO_BASE_ADDR + FIFO_TX_DATA) =
+					((unsigned int)pChunk->u16_buff[pThis->txOffset + samplesInChunk]) << 16;
+			*(volatile u32 *) (FIFO_BASE_ADDR + FIFO_TX_LENGTH) = 0x1;
+		}
+		pThis->txOffset += n;
+		written         += n;
+		quota           -= n;
+		vacancy         -= n;
+
+		/* Return a finished chunk to buffer pool free list */
+		if (pThis->txOffset == pChunk->bytesUsed/sizeof(unsigned int)) {
+			audioRxTx_txAccount(pThis, pChunk);
+			if (fromIsr) {
+				bufferPool_d_release_from_ISR(pThis->pBuffP, pChunk);
+			} else {
+				bufferPool_d_release(pThis->pBuffP, pChunk);
+			}
+			pThis->pTxPending = NULL;
+		}
+	}
+	return written;
+}
+
+/** Audio ISR (FIFO)
+ *   - TFPE: one chunk worth of samples into the TX FIFO (as far as it
+ *     has room, the rest follows on the next TFPE)
+ *   - RFPF: the whole RX FIFO into chunks, a chunk is queued once full
+ *     so chunks keep the profile size whatever the FIFO threshold is
  *
  * Parameters:
  * @param pThisArg  Initialized Audio (TX/RX) object
@@ -97,95 +268,89 @@ int audioRxTx_get(audioRxTx_t *pThis, chunk_d_t **pChunk)
 void audioRxTx_isr(void *pThisArg) {
 	audioRxTx_t *pThis = (audioRxTx_t*) pThisArg;
 	chunk_d_t *pChunk = NULL;
-	unsigned int samplesInChunk;
+	unsigned int samplesInFifo, samplesInChunk;
 
-	/* Read FIFO Interrupt Status */
+	/* Read FIFO Interrupt Status (TFPE status is latched even while masked) */
 	unsigned int intStatus =
-			*(volatile u32 *) (FIFO_BASE_ADDR + FIFO_INT_STATUS);
+			*(volatile u32 *) (FIFO_BASE_ADDR + FIFO_INT_STATUS)
+			& *(volatile u32 *) (FIFO_BASE_ADDR + FIFO_INT_ENABLE);
 
 														/* Tx FIFO programmable empty hit */
 	if (intStatus & FIFO_INT_TFPE) {
 		/* clear TFPE interrupt */
 		*(volatile u32 *) (FIFO_BASE_ADDR + FIFO_INT_STATUS) = FIFO_INT_TFPE;
 
-		/* Check if Tx queue is EMPTY
-		 *  - set signal that ISR is not running
-		 *  - return */
-		if (xQueueIsQueueEmptyFromISR(pThis->tx_queue) != pdFALSE) {
+		/* Nothing left to send (underrun)
+		 *  - mask TFPE, the task primes the FIFO again
+		 *  - set signal that ISR is not running */
+		if (0 == audioRxTx_txFill(pThis, pThis->pBuffP->bytesPerChunk/sizeof(unsigned int), 1)) {
+			*(volatile u32 *) (FIFO_BASE_ADDR + FIFO_INT_ENABLE) &= ~FIFO_INT_TFPE;
 			pThis->running = 0; /* indicate that ISR is no longer running */
-			return;
-		}
-
-		// Tx Queue is not empty - Receive pointer to the next chunk.
-		xQueueReceiveFromISR(pThis->tx_queue, &pChunk, NULL);
-
-		/* how many samples does the chunk contain ? */
-		samplesInChunk = pChunk->bytesUsed/sizeof(unsigned int);
-
-		// This check might not really be needed - as we have recieved a TPFE trigger from FIFO
-		if (samplesInChunk  > (*(volatile u32 *) (FIFO_BASE_ADDR + FIFO_TX_VAC))) {
-			printf("audioTx_isr: insufficient space in FIFO\n");
-			// should anyway never happen
-
-			// if TX FIFO Does not have the space promised, just drop the chunk
-			bufferPool_d_release_from_ISR(pThis->pBuffP, pChunk);
-			return;
-		}
-		/* Transmit the chunk data to the TX FIFO */
-		u32 samplNr = 0;
-		for (samplNr = 0; samplNr < samplesInChunk; samplNr++) {
-
-			*(volatile u32 *) (FIFO_BASE_ADDR + FIFO_TX_DATA) =
-					((unsigned int)pChunk->u16_buff[samplNr]) << 16;
-			*(volatile u32 *) (FIFO_BASE_ADDR + FIFO_TX_LENGTH) = 0x1;
 		}
-
-		/* Return chunk to buffer pool free list */
-		bufferPool_d_release_from_ISR(pThis->pBuffP, pChunk);
 	}
 
 														/* RX FIFO programmable Full hit */
 	if (intStatus & FIFO_INT_RFPF) {
 		/* Clear RFPF interrupt */
 		*(volatile u32 *) (FIFO_BASE_ADDR + FIFO_INT_STATUS) = FIFO_INT_RFPF;
-		/* is Queue is full ? */
-		if ((xQueueIsQueueFullFromISR(pThis->rx_queue)) != pdFALSE) {
-			printf(
-					"The RX queue is full, and no more incoming data could be captured\n");
-			*(volatile u32 *) (FIFO_BASE_ADDR + FIFO_INT_ENABLE) = 0x0;
-			return;
-		}
 
-		while (bufferPool_d_acquire_ISR(pThis->pBuffP, &pChunk) != 1) {
-			printf("RX ISR: buffer pool empty\n\n\n\n\n");
-			*(volatile u32 *) (FIFO_BASE_ADDR + FIFO_INT_ENABLE) = 0x0;
-			return;
+		// How many samples in FIFO? Read them all, RFPF fires on the next crossing only
+		samplesInFifo = *(volatile u32 *) (FIFO_BASE_ADDR + FIFO_RX_OCC);
+
+		while (samplesInFifo) {
+			/* RX queue at its depth limit or pool empty: the audio task fell
+			 * behind - recycle the oldest queued chunk and keep capturing */
+			if (NULL == pThis->pPending) {
+				if (uxQueueMessagesWaitingFromISR(pThis->rx_queue) >= pThis->rxDepth
+						|| bufferPool_d_acquire_ISR(pThis->pBuffP, &pThis->pPending) != 1) {
+					pThis->seq.rxOverruns++;
+					if (pdTRUE != xQueueReceiveFromISR(pThis->rx_queue, &pThis->pPending, NULL)) {
+						/* no chunk at all - discard whole L/R frames so RFPF clears
+						 * and the next chunk still starts on L */
+						pThis->pPending = NULL;
+						samplesInFifo &= ~1u;
+						while (samplesInFifo--) {
+							(void) *(volatile u32 *) (FIFO_BASE_ADDR + FIFO_RX_DATA);
+						}
+						break;
+					}
+				}
+				pThis->pPending->bytesUsed = 0;
+			}
+			pChunk = pThis->pPending;
+
+			// more samples in FIFO than fitting into chunk? Limit
+			samplesInChunk = (pChunk->bytesMax - pChunk->bytesUsed)/4;
+			if (samplesInChunk > samplesInFifo) {
+				samplesInChunk = samplesInFifo;
+			}
+			samplesInFifo -= samplesInChunk;
+
+			/* Read the Audio RX samples.*/
+			u32 samplNr = pChunk->bytesUsed/4;
+			for (; samplesInChunk--; samplNr++) {
+
+				// read from FIFO and right shift by 16 (8 LSBs are 0 anyway, plus we want to use 16 bit only).
+				// symmetric to tx side.
+				pChunk->u16_buff[samplNr] = (unsigned short) ((*(volatile u32 *) (FIFO_BASE_ADDR
+				                                        + FIFO_RX_DATA)) >> 16);
+			}
+
+			/* indicate fill level, queue the chunk once it is full */
+			pChunk->bytesUsed = samplNr * 4;
+			if (pChunk->bytesUsed < pChunk->bytesMax) {
+				break;
+			}
+
+			/* capture metadata */
+			pChunk->seq      = pThis->seq.rxSeq++;
+			pChunk->tCapture = timeStamp_get();
+			pChunk->streamId = CHUNK_STREAM_RX;
+			pChunk->channels = 2;
+
+			xQueueSendFromISR( pThis->rx_queue, &pChunk, NULL);
+			pThis->pPending = NULL;
 		}
-
-		// How many samples in FIFO?
-		samplesInChunk =  *(volatile u32 *) (FIFO_BASE_ADDR + FIFO_RX_OCC);
-
-		// more samples in FIFO than fitting into chunk? Limit
-		if(samplesInChunk > pChunk->bytesMax/4){
-			samplesInChunk = pChunk->bytesMax/4;
-		}
-
-		/* Read the Audio RX samples.*/
-		u32 samplNr = 0;
-		for (samplNr = 0; samplNr < samplesInChunk; samplNr++) {
-
-			// read from FIFO and right shift by 16 (8 LSBs are 0 anyway, plus we want to use 16 bit only).
-			// symmetric to tx side.
-			pChunk->u16_buff[samplNr] = (unsigned short) ((*(volatile u32 *) (FIFO_BASE_ADDR
-			                                        + FIFO_RX_DATA)) >> 16);
-		}
-
-		/* indicate max fill level */
-		pChunk->bytesUsed= samplesInChunk * 4;
-
-		xQueueSendFromISR( pThis->rx_queue, &pChunk, NULL);
-		return;
-
 	}
 
 														/* did neither RX nor TX interrupt hit? */
@@ -201,6 +366,26 @@ void audioRxTx_isr(void *pThisArg) {
 
 
 
+/** write queued chunks into the TX FIFO as far as it has room,
+ *  then hand TX over to the ISR
+ * Parameters:
+ * @param pThis  Instance of the Audio (RX/TX) object.
+ */
+static void audioRxTx_prime(audioRxTx_t *pThis)
+{
+	/* TFPE is masked - the ISR does not touch the TX side meanwhile;
+	 * a chunk that does not fit any more is finished by the ISR */
+	audioRxTx_txFill(pThis, ~0u, 0);
+
+	/* FIFO is above its programmable empty threshold now: drop the stale
+	 * TFPE status and let the ISR stream from here */
+	taskENTER_CRITICAL();
+	pThis->running = 1;
+	*(volatile u32 *) (FIFO_BASE_ADDR + FIFO_INT_STATUS) = FIFO_INT_TFPE;
+	*(volatile u32 *) (FIFO_BASE_ADDR + FIFO_INT_ENABLE) |= FIFO_INT_TFPE;
+	taskEXIT_CRITICAL();
+}
+
 /** audio tx put
  *   Copies filled pChunk into the TX queue for transmission
  *    if queue is full, then chunk is dropped 
@@ -212,38 +397,39 @@ void audioRxTx_isr(void *pThisArg) {
  */
 int audioRxTx_put(audioRxTx_t *pThis, chunk_d_t *pChunk)
 {
-    unsigned int sampleNr = 0;
     if ( NULL == pThis || NULL == pChunk ) {
         printf("[TX]: Chunk/Audio objects not initialized \r\n");
         return -1;
     }
     
     
-    /* ISR/polled execution ? */
+    /* start/underrun: collect chunks, prime the FIFO once enough are queued */
     if ( 0 == pThis->running ) {
-    	unsigned int samplesInChunk = pChunk->bytesUsed/sizeof(unsigned int);
-
-    	/* Do polled transfer - by checking TX VACANCY in the FIFO */
-    	while( samplesInChunk > (*(volatile u32 *) (FIFO_BASE_ADDR + FIFO_TX_VAC)));
-
-    	for(sampleNr=0;sampleNr < samplesInChunk;sampleNr++) {
-        	*(volatile u32 *) (FIFO_BASE_ADDR + FIFO_TX_DATA) = ((unsigned int)pChunk->u16_buff[sampleNr]) << 16;
-        	*(volatile u32 *) (FIFO_BASE_ADDR + FIFO_TX_LENGTH) = 0x1;
-        }
-
-        /* chunk data has been copied into the TX FIFO, release chunk to the free list*/
-        bufferPool_d_release((pThis->pBuffP), pChunk);
-
-        /* Enable TX ISR mode */
-        pThis->running = 1;
-        return 0;
+    	if (pdPASS != xQueueSend(pThis->tx_queue, &pChunk, 0)) {
+    		pThis->seq.txDrops++;
+    		bufferPool_d_release(pThis->pBuffP, pChunk);
+    		return -1;
+    	}
+    	if (uxQueueMessagesWaiting(pThis->tx_queue) >= pThis->primeChunks) {
+    		audioRxTx_prime(pThis);
+    	}
+    	return 0;
     }
 
     else{
-        /* ISR is already running, add chunk to TX queue and it will be processed in ISR*/
-    	while(xQueueSend( pThis->tx_queue,  &pChunk, ( TickType_t ) 100) != pdPASS) {
-    		printf("TX Queue is full, loop until TX FIFO drains.\n");
-    	}
+        /* hold the TX queue fill just above the observed jitter */
+        jitterCtl_observe(&pThis->jitter, uxQueueMessagesWaiting(pThis->tx_queue),
+                pChunk->bytesUsed/sizeof(unsigned int)/JITTER_CHANNELS);
+        jitterCtl_apply(&pThis->jitter, pChunk);
+
+        /* queue at its depth limit - TX is behind, drop the chunk rather than
+         * block the audio task while RX keeps filling */
+        if (uxQueueMessagesWaiting(pThis->tx_queue) >= pThis->txDepth
+        		|| xQueueSend(pThis->tx_queue, &pChunk, 0) != pdPASS) {
+        	pThis->seq.txDrops++;
+        	bufferPool_d_release(pThis->pBuffP, pChunk);
+        	return -1;
+        }
     }
     return 0;
 
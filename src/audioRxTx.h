@@ -20,6 +20,8 @@
 #include "bufferPool_d.h"
 #include "adau1761.h"
 #include "audioSample.h"
+#include "jitterCtl.h"
+#include "latencyProbe.h"
 
 
 /***************************************************
@@ -27,24 +29,56 @@
 ***************************************************/   
 /**
  * @def AUDIOTX_QUEUE_DEPTH
- * @brief tx queue depth
+ * @brief tx/rx queue capacity, audioRxTx_configure() sets the depth
+ *        actually used (at most this)
  */
 #define AUDIOTX_QUEUE_DEPTH 30
 #define AUDIORX_QUEUE_DEPTH 30
 
+/**
+ * @def AUDIOTX_PRIME_CHUNKS
+ * @brief chunks collected and written to the TX FIFO before TFPE is enabled
+ */
+#define AUDIOTX_PRIME_CHUNKS 2
+
 /***************************************************
             DATA TYPES
 ***************************************************/
 
+/** chunk sequence/timing statistics, checked when RX-derived chunks
+ *  (CHUNK_STREAM_RX/MIX) are written to the TX FIFO
+ */
+typedef struct {
+  unsigned int rxSeq;        /* next RX sequence number */
+  unsigned int txLastSeq;    /* sequence number of the last TX chunk */
+  int          txSeqValid;   /* txLastSeq is set */
+  unsigned int txGaps;       /* RX chunks that never reached TX */
+  unsigned int txReorders;   /* chunks sent out of order */
+  unsigned int txLatency;    /* last capture-to-TX time (time stamp ticks) */
+  unsigned int txLatencyMax; /* worst capture-to-TX time (time stamp ticks) */
+  unsigned int rxOverruns;   /* RX captures that recycled a queued chunk or were discarded */
+  unsigned int txDrops;      /* chunks dropped by audioRxTx_put (TX queue full) */
+} audioRxTx_seqStats_t;
+
 /** audio RX and TX objects
  */
 typedef struct {
   QueueHandle_t rx_queue;  /* queue for received buffers */
   QueueHandle_t tx_queue;  /* queue for transmit buffers */
-  chunk_d_t        *pPending; /* pointer to pending chunk just in receiving */
+  chunk_d_t        *pPending; /* RX chunk being filled, queued once full */
+  chunk_d_t        *pTxPending; /* TX chunk partly written to the FIFO */
+  unsigned int     txOffset; /* samples of pTxPending already written */
   bufferPool_d_t   *pBuffP; /* pointer to buffer pool */
   audioSample_t  audioSample;
-  int              running; /* ISR/polling - which one should execute? */
+  volatile int     running; /* 1: TX ISR streaming, 0: collecting chunks to prime the FIFO */
+  jitterCtl_t      jitter;  /* keeps the TX queue fill near the observed jitter */
+  unsigned int     txFifoDepth; /* TX FIFO words (vacancy of the empty FIFO) */
+  unsigned int     txDepth;  /* TX queue depth limit */
+  unsigned int     rxDepth;  /* RX queue depth limit */
+  unsigned int     primeChunks; /* chunks primed into the TX FIFO */
+  audioRxTx_seqStats_t seq; /* drops, reorders and per-chunk latency */
+  APP_QUEUE_STORAGE(rx_queue, AUDIORX_QUEUE_DEPTH, sizeof(chunk_d_t*))
+  APP_QUEUE_STORAGE(tx_queue, AUDIOTX_QUEUE_DEPTH, sizeof(chunk_d_t*))
 } audioRxTx_t;
 
 
@@ -67,6 +101,30 @@ typedef struct {
  */
 int audioRxTx_init(audioRxTx_t *pThis, bufferPool_d_t *pBuffP);
 
+/** Stop streaming
+ *    - masks the FIFO interrupts, resets the FIFOs and empties both
+ *      queues (queued chunks are abandoned, the caller re-initializes
+ *      the buffer pool)
+ * Parameters:
+ * @param pThis  pointer to own object
+ */
+void audioRxTx_stop(audioRxTx_t *pThis);
+
+/** (Re)configure the streaming path
+ *    - stops streaming (audioRxTx_stop)
+ *    - sets the queue depth limits and the TX prime depth
+ *    - re-enables RX, TX starts again once primed
+ * Parameters:
+ * @param pThis        pointer to own object
+ * @param txDepth      TX queue depth (1..AUDIOTX_QUEUE_DEPTH)
+ * @param rxDepth      RX queue depth (1..AUDIORX_QUEUE_DEPTH)
+ * @param primeChunks  chunks written to the TX FIFO before TFPE is enabled
+ *
+ * @return Zero on success.
+ * Negative value on failure.
+ */
+int audioRxTx_configure(audioRxTx_t *pThis, unsigned int txDepth, unsigned int rxDepth, unsigned int primeChunks);
+
 /** start audio tx
  *   - empthy for now
  * Parameters:
@@ -79,10 +137,11 @@ int audioRxTx_start(audioRxTx_t *pThis);
 
 
 /** audio rtx isr  (to be called from dispatcher) 
- *   - get chunk from tx queue
- *    - if valid, release old pending chunk to buffer pool 
- *    - configure DMA 
- *    - if not valide, configure DMA to replay same chunk again
+ *   - TFPE: writes one chunk worth of samples to the TX FIFO, a chunk
+ *     larger than the vacancy is continued on the next TFPE; nothing
+ *     queued stops TX until the task primes the FIFO again
+ *   - RFPF: empties the RX FIFO into chunks, queues each chunk once it
+ *     is full, so chunks have the pool chunk size for any FIFO threshold
  * Parameters:
  * @param pThis  pointer to own object
  *
@@ -93,6 +152,8 @@ void audioRxTx_isr(void *pThis);
 /** audioRxTx put
  *   copies filled pChunk into the TX queue for transmission
  *    if queue is full, then chunk is dropped 
+ *   at start and after an underrun the TX FIFO is primed with
+ *   AUDIOTX_PRIME_CHUNKS chunks before the TX ISR takes over
  * Parameters:
  * @param pThis  pointer to own object
  *
@@ -116,6 +177,15 @@ int audioRxTx_put(audioRxTx_t *pThis, chunk_d_t *pChunk);
  */
 int audioRxTx_get(audioRxTx_t *pThis, chunk_d_t **pChunk);
 
+/** audioRxTx path fill
+ *   FIFO slots (L,R interleaved) buffered in FIFOs and queues right now
+ * Parameters:
+ * @param pThis         pointer to own object
+ * @param chunkSamples  slots per queued chunk
+ * @param pPath         filled with the fill levels
+ */
+void audioRxTx_getPath(audioRxTx_t *pThis, unsigned int chunkSamples, latencyProbe_path_t *pPath);
+
 
 
 #endif
@@ -14,6 +14,9 @@
 #include "chunk_d.h"
 #include <string.h>
 #include "audioSample.h"
+#include "zedboard_freertos.h"
+#include "timeStamp.h"
+#include "appConfig.h"
 #include <assert.h>
 //#include "snd_sample.c"
 
@@ -28,23 +31,91 @@ extern unsigned int snd_samples_nSamples;
  */
 int audioSample_init(audioSample_t *pThis) {
 
-  pThis->pmem   = snd_samples;
+  pThis->pmem   = (unsigned char *) snd_samples;
   pThis->size   = snd_samples_nSamples * sizeof(unsigned int);
   pThis->count  = 0;
+  pThis->format = AUDIOSAMPLE_FMT_RAW;
 
   return 1;
 }
 
 /**
- * Initialize the audioSample structure
- *  - set the memory start
- *  - set the size of the memory that has sound samples
- *  - set the initial count
+ * Initialize the audioSample structure on a compressed clip
+ *  - attach the ADPCM decoder to the clip
+ *  - size is the decoded length in FIFO words (L and R slot per sample)
+ *  - clips are not resampled, only AUDIO_SAMPLE_RATE clips are accepted
+ */
+int audioSample_initClip(audioSample_t *pThis, const adpcm_clip_t *pClip) {
+
+  if (AUDIO_SAMPLE_RATE != pClip->sampleRate) {
+    printf("[SAMPLE]: clip %s is %u Hz, need %u Hz\r\n", pClip->name, pClip->sampleRate, AUDIO_SAMPLE_RATE);
+    return -1;
+  }
+
+  if (PASS != adpcm_decoder_init(&pThis->decoder, pClip)) {
+    return -1;
+  }
+
+  pThis->pmem   = (unsigned char *) pClip->pData;
+  pThis->size   = pClip->nSamples * 2 * sizeof(unsigned int);
+  pThis->count  = 0;
+  pThis->format = AUDIOSAMPLE_FMT_ADPCM;
+
+  return PASS;
+}
+
+/**
+ * Stamp a produced chunk with the clip stream metadata
+ */
+static void audioSample_stamp(audioSample_t *pThis, chunk_d_t *pchunk_rx) {
+
+  pchunk_rx->seq      = pThis->seq++;
+  pchunk_rx->tCapture = timeStamp_get();
+  pchunk_rx->streamId = CHUNK_STREAM_CLIP;
+}
+
+/**
+ * Decode the next chunk of an ADPCM clip
+ *  - mono clip: each sample goes to the left and the right FIFO word
+ *  - rewind at end of clip
+ */
+static int audioSample_getAdpcm(audioSample_t *pThis, chunk_d_t *pchunk_rx) {
+
+  int samples = adpcm_decode(&pThis->decoder, pchunk_rx->s16_buff,
+                             pchunk_rx->bytesMax / sizeof(unsigned int) / 2);
+  int n;
+
+  /* spread to L,R frames, back to front in place */
+  for (n = samples; n-- > 0; ) {
+    pchunk_rx->s16_buff[2 * n + 1] = pchunk_rx->s16_buff[n];
+    pchunk_rx->s16_buff[2 * n]     = pchunk_rx->s16_buff[n];
+  }
+
+  pchunk_rx->bytesUsed = 2 * samples * sizeof(unsigned int);
+  pThis->count += pchunk_rx->bytesUsed;
+  audioSample_stamp(pThis, pchunk_rx);
+
+  if (pThis->count >= pThis->size) {
+    adpcm_decoder_rewind(&pThis->decoder);
+    pThis->count = 0;
+  }
+
+  return pchunk_rx->bytesUsed;
+}
+
+/**
+ * Copy the next part of the sample into the chunk
+ *  - raw samples are copied, ADPCM clips are decoded
+ *  - wrap around at the end of the sample
  */
 int audioSample_get(audioSample_t *pThis, chunk_d_t *pchunk_rx) {
 
   int count = 0;
 
+  if (AUDIOSAMPLE_FMT_ADPCM == pThis->format) {
+    return audioSample_getAdpcm(pThis, pchunk_rx);
+  }
+
   /** Check if we are not copying more than our audio sample */
   pThis->count += pchunk_rx->bytesMax;
   if ( pThis->count < pThis->size ) {
@@ -65,6 +136,7 @@ int audioSample_get(audioSample_t *pThis, chunk_d_t *pchunk_rx) {
   printf("The chunk data[%d] is %d\n",i, pchunk_rx->u32_buff[i]);
   } */
   pchunk_rx->bytesUsed = count;
+  audioSample_stamp(pThis, pchunk_rx);
   
   if (pThis->count >= pThis->size)
     pThis->count = 0;
@@ -18,10 +18,15 @@
 #define _AUDIO_SAMPLE_H_
 
 #include"chunk_d.h"
+#include "adpcm.h"
 /***************************************************
             DEFINES
 ***************************************************/   
 
+/** sample storage formats */
+#define AUDIOSAMPLE_FMT_RAW   0 /* raw words from snd_samples[] */
+#define AUDIOSAMPLE_FMT_ADPCM 1 /* IMA-ADPCM clip from the sample bank */
+
 
 /***************************************************
             DATA TYPES
@@ -33,14 +38,44 @@ typedef struct {
   unsigned char *pmem;
   unsigned int  size;
   unsigned int  count;
+  int             format;  /* AUDIOSAMPLE_FMT_RAW or AUDIOSAMPLE_FMT_ADPCM */
+  adpcm_decoder_t decoder; /* decoder state for ADPCM clips */
+  unsigned int    seq;     /* sequence number of the next chunk */
 }audioSample_t;
 
+/* compressed sample bank (generated by tools/wav2adpcm.c) */
+extern const adpcm_clip_t snd_bank[];
+extern const unsigned int snd_bank_nClips;
+
 
 /***************************************************
             Access Methods 
 ***************************************************/
 
 int audioSample_init(audioSample_t *pThis);
+
+/** Initialize the audioSample structure on an ADPCM clip
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ * @param pClip  clip to play (e.g. &snd_bank[n]), recorded at AUDIO_SAMPLE_RATE
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure (e.g. other sample rate).
+ */
+int audioSample_initClip(audioSample_t *pThis, const adpcm_clip_t *pClip);
+
+/** Fill a chunk with the next part of the sample
+ *   - ADPCM clips are decoded chunk at a time, each (mono) sample into
+ *     the left and the right FIFO word (interleaved like the RX/TX path)
+ *   - rewinds to the start after the last chunk
+ *
+ * Parameters:
+ * @param pThis      pointer to own object
+ * @param pchunk_rx  chunk to fill
+ *
+ * @return number of bytes put into the chunk
+ */
 int audioSample_get(audioSample_t *pThis, chunk_d_t *pchunk_rx);
 
 #endif
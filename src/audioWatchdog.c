@@ -0,0 +1,125 @@
+/**
+ *@file audioWatchdog.c
+ *
+ *@brief
+ *  - deadline watchdog for the audio task
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#include <string.h>
+#include "audioWatchdog.h"
+#include "timeStamp.h"
+#include "zedboard_freertos.h"
+
+/* shed order: analyzer first, recorder last */
+static const unsigned int audioWatchdog_shedOrder[] = {
+	AUDIOWD_STAGE_ANALYZER, AUDIOWD_STAGE_METERS, AUDIOWD_STAGE_RECORDER
+};
+#define SHED_NUM (sizeof(audioWatchdog_shedOrder) / sizeof(audioWatchdog_shedOrder[0]))
+
+/* Initialize the watchdog */
+int audioWatchdog_init(audioWatchdog_t *pThis, unsigned int frames, unsigned int sampleRate)
+{
+	if (NULL == pThis || 0 == frames || 0 == sampleRate) {
+		printf("[AWD]: Failed Init\r\n");
+		return -1;
+	}
+
+	memset(pThis, 0, sizeof(*pThis));
+	pThis->deadline = TIMESTAMP_FROM_US(((unsigned long long) frames * 1000000) / sampleRate);
+	pThis->stages   = AUDIOWD_STAGE_ALL;
+	pThis->autoShed = 1;
+
+	return PASS;
+}
+
+/* Start of a chunk period */
+void audioWatchdog_begin(audioWatchdog_t *pThis)
+{
+	pThis->start = timeStamp_get();
+}
+
+/** shed the next optional stage still running */
+static void audioWatchdog_shed(audioWatchdog_t *pThis)
+{
+	unsigned int i;
+
+	for (i = 0; i < SHED_NUM; i++) {
+		if (pThis->stages & audioWatchdog_shedOrder[i]) {
+			pThis->stages &= ~audioWatchdog_shedOrder[i];
+			pThis->sheds++;
+			return;
+		}
+	}
+}
+
+/** restore the last shed stage */
+static void audioWatchdog_restore(audioWatchdog_t *pThis)
+{
+	int i;
+
+	for (i = SHED_NUM - 1; i >= 0; i--) {
+		if (!(pThis->stages & audioWatchdog_shedOrder[i])) {
+			pThis->stages |= audioWatchdog_shedOrder[i];
+			return;
+		}
+	}
+}
+
+/* End of chunk processing */
+int audioWatchdog_end(audioWatchdog_t *pThis)
+{
+	unsigned int elapsed = timeStamp_get() - pThis->start;
+
+	if (elapsed > pThis->worst) {
+		pThis->worst = elapsed;
+	}
+
+	if (elapsed <= pThis->deadline) {
+		pThis->lateRun = 0;
+		if (++pThis->onTimeRun >= AUDIOWD_RESTORE_CHUNKS) {
+			pThis->onTimeRun = 0;
+			if (pThis->autoShed) {
+				audioWatchdog_restore(pThis);
+			}
+		}
+		return 1;
+	}
+
+	pThis->misses++;
+	pThis->onTimeRun = 0;
+	if (++pThis->lateRun >= AUDIOWD_SHED_MISSES) {
+		pThis->lateRun = 0;
+		if (pThis->autoShed) {
+			audioWatchdog_shed(pThis);
+		}
+	}
+	return 0;
+}
+
+/* Report shed stages */
+void audioWatchdog_report(audioWatchdog_t *pThis)
+{
+	unsigned int sheds = pThis->sheds;
+
+	if (sheds == pThis->reported) {
+		return;
+	}
+	printf("[AWD]: %u misses, %u stages shed, enabled 0x%x\r\n",
+			pThis->misses, sheds - pThis->reported, pThis->stages);
+	pThis->reported = sheds;
+}
+
+/* Enable/disable automatic shedding */
+void audioWatchdog_setAutoShed(audioWatchdog_t *pThis, int enable)
+{
+	pThis->autoShed = enable;
+	if (!enable) {
+		pThis->stages = AUDIOWD_STAGE_ALL;
+	}
+}
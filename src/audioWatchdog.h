@@ -0,0 +1,121 @@
+/**
+ *@file audioWatchdog.h
+ *
+ *@brief
+ *  - deadline watchdog for the audio task
+ *  - every chunk has to be processed within one chunk period
+ *    (frames / sample rate); late chunks are counted as misses
+ *  - on repeated misses optional processing stages are shed one at a
+ *    time and restored again once the task keeps its deadline
+ *
+ * Usage in the audio loop:
+ *   audioWatchdog_begin()       chunk received
+ *   if (audioWatchdog_enabled(..., AUDIOWD_STAGE_xxx)) optional stage
+ *   audioWatchdog_end()         chunk handed to TX
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#ifndef _AUDIO_WATCHDOG_H_
+#define _AUDIO_WATCHDOG_H_
+
+/***************************************************
+            DEFINES
+***************************************************/
+
+/** optional stages, in the order they are shed (last one first) */
+#define AUDIOWD_STAGE_RECORDER (1 << 0)  /* RX capture ring */
+#define AUDIOWD_STAGE_METERS   (1 << 1)  /* OLED level meters (TTC meter job) */
+#define AUDIOWD_STAGE_ANALYZER (1 << 2)  /* spectrum analyzer */
+#define AUDIOWD_STAGE_ALL      (AUDIOWD_STAGE_RECORDER | AUDIOWD_STAGE_METERS | AUDIOWD_STAGE_ANALYZER)
+
+/** consecutive misses before one more stage is shed */
+#define AUDIOWD_SHED_MISSES 2
+
+/** consecutive chunks on time before one stage is restored */
+#define AUDIOWD_RESTORE_CHUNKS 256
+
+/***************************************************
+            DATA TYPES
+***************************************************/
+
+/** audio deadline watchdog object */
+typedef struct {
+  unsigned int          deadline;    /* chunk period in time stamp ticks */
+  unsigned int          start;       /* time stamp of current chunk */
+  unsigned int          worst;       /* longest chunk processing time (ticks) */
+  unsigned int          misses;      /* chunks that missed the deadline */
+  unsigned int          lateRun;     /* consecutive misses */
+  unsigned int          onTimeRun;   /* consecutive chunks on time */
+  unsigned int          autoShed;    /* shedding on misses enabled */
+  volatile unsigned int stages;      /* AUDIOWD_STAGE_xxx enabled */
+  volatile unsigned int sheds;       /* stages shed so far */
+  unsigned int          reported;    /* sheds already reported */
+} audioWatchdog_t;
+
+
+/***************************************************
+            Access Methods
+***************************************************/
+
+/** Initialize the watchdog, all stages enabled
+ *
+ * Parameters:
+ * @param pThis       pointer to own object
+ * @param frames      L/R frames per chunk (FIFO slots / channels)
+ * @param sampleRate  sample rate (Hz)
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure.
+ */
+int audioWatchdog_init(audioWatchdog_t *pThis, unsigned int frames, unsigned int sampleRate);
+
+/** Mark the start of a chunk period (chunk received)
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ */
+void audioWatchdog_begin(audioWatchdog_t *pThis);
+
+/** Mark the end of chunk processing, count a miss when late and
+ *  shed/restore optional stages
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ *
+ * @return 1 if the chunk was on time, 0 if it missed its deadline
+ */
+int audioWatchdog_end(audioWatchdog_t *pThis);
+
+/** Check whether an optional stage should run
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ * @param stage  AUDIOWD_STAGE_xxx
+ *
+ * @return non-zero if the stage is enabled
+ */
+#define audioWatchdog_enabled(pThis, stage) ((pThis)->stages & (stage))
+
+/** Print misses and shed stages if stages were shed since the last call
+ *   - for a low priority task (the GPIO task polls it), the audio task
+ *     only counts
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ */
+void audioWatchdog_report(audioWatchdog_t *pThis);
+
+/** Enable or disable automatic shedding (disabling restores all stages)
+ *
+ * Parameters:
+ * @param pThis   pointer to own object
+ * @param enable  non-zero to shed stages on misses
+ */
+void audioWatchdog_setAutoShed(audioWatchdog_t *pThis, int enable);
+
+#endif
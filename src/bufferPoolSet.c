@@ -0,0 +1,101 @@
+/**
+ *@file bufferPoolSet.c
+ *
+ *@brief
+ *  - set of buffer pools in several size classes
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#include "bufferPoolSet.h"
+
+/* class geometry, smallest first */
+static const unsigned int bufferPoolSet_bytes[BPSET_CLASS_NUM] = {
+	BPSET_CLASS0_BYTES, BPSET_CLASS1_BYTES, BPSET_CLASS2_BYTES, BPSET_CLASS3_BYTES
+};
+static const unsigned int bufferPoolSet_chunks[BPSET_CLASS_NUM] = {
+	BPSET_CLASS0_CHUNKS, BPSET_CLASS1_CHUNKS, BPSET_CLASS2_CHUNKS, BPSET_CLASS3_CHUNKS
+};
+
+/* Initialize all size classes */
+int bufferPoolSet_init(bufferPoolSet_t *pThis, bufferPoolSet_storage_t *pStore)
+{
+	int n, status;
+#if APP_STATIC_ALLOC
+	chunk_d_t *pChunkMem[BPSET_CLASS_NUM];
+	unsigned char *pArenaMem[BPSET_CLASS_NUM];
+	unsigned char *pFreeListMem[BPSET_CLASS_NUM];
+
+	if (NULL == pThis || NULL == pStore) {
+		printf("[BP_SET]: Failed Init\r\n");
+		return -1;
+	}
+
+	/* per class views of the consumer's storage */
+	pChunkMem[0] = pStore->chunks0; pArenaMem[0] = pStore->arena0; pFreeListMem[0] = pStore->freeList0;
+	pChunkMem[1] = pStore->chunks1; pArenaMem[1] = pStore->arena1; pFreeListMem[1] = pStore->freeList1;
+	pChunkMem[2] = pStore->chunks2; pArenaMem[2] = pStore->arena2; pFreeListMem[2] = pStore->freeList2;
+	pChunkMem[3] = pStore->chunks3; pArenaMem[3] = pStore->arena3; pFreeListMem[3] = pStore->freeList3;
+#else
+	if (NULL == pThis || NULL != pStore) {
+		printf("[BP_SET]: Failed Init\r\n");
+		return -1;
+	}
+#endif
+
+	for (n = 0; n < BPSET_CLASS_NUM; n++) {
+#if APP_STATIC_ALLOC
+		status = bufferPool_d_initStatic(&pThis->pools[n], bufferPoolSet_chunks[n], bufferPoolSet_bytes[n],
+				pChunkMem[n], pArenaMem[n], pFreeListMem[n]);
+#else
+		status = bufferPool_d_init(&pThis->pools[n], bufferPoolSet_chunks[n], bufferPoolSet_bytes[n]);
+#endif
+		if (PASS != status) {
+			printf("[BP_SET]: Failed to init class %u bytes\r\n", bufferPoolSet_bytes[n]);
+			return -1;
+		}
+	}
+
+	return PASS;
+}
+
+/* Get a chunk of at least 'bytes' bytes */
+int bufferPool_acquire_size(bufferPoolSet_t *pThis, unsigned int bytes, chunk_d_t **ppChunk)
+{
+	int n;
+
+	*ppChunk = NULL;
+	for (n = 0; n < BPSET_CLASS_NUM; n++) {
+		if (bytes <= bufferPoolSet_bytes[n]
+				&& 1 == bufferPool_d_acquire(&pThis->pools[n], ppChunk)) {
+			return 1;
+		}
+	}
+	return -1;
+}
+
+/* Release a chunk to its class */
+int bufferPool_release_size(bufferPoolSet_t *pThis, chunk_d_t *pChunk)
+{
+	int n;
+
+	if (NULL == pChunk) {
+		return -1;
+	}
+
+	/* the class owning the chunk's data */
+	for (n = 0; n < BPSET_CLASS_NUM; n++) {
+		const bufferPool_d_t *pPool = &pThis->pools[n];
+
+		if (pChunk->u08_buff >= pPool->pArena && pChunk->u08_buff < pPool->pArena + pPool->arenaBytes) {
+			return bufferPool_d_release(&pThis->pools[n], pChunk);
+		}
+	}
+
+	printf("[BP_SET]: chunk not from this set\r\n");
+	return -1;
+}
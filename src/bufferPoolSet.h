@@ -0,0 +1,111 @@
+/**
+ *@file bufferPoolSet.h
+ *
+ *@brief
+ *  - set of buffer pools in several size classes
+ *  - bufferPool_acquire_size() takes a chunk from the smallest class that
+ *    fits the request (falling back to larger classes when it is empty),
+ *    so small consumers do not tie up worst-case sized chunks
+ *  - each class is an ordinary bufferPool_d_t with its own free list
+ *  - shared infrastructure for non-streaming buffers (FFT scratch,
+ *    recorder segments, control messages); the module reserves no memory
+ *    itself: the heap is used at init, or with APP_STATIC_ALLOC the
+ *    storage the consumer declares (bufferPoolSet_storage_t)
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#ifndef _BUFFER_POOL_SET_H_
+#define _BUFFER_POOL_SET_H_
+
+#include "bufferPool_d.h"
+
+/***************************************************
+            DEFINES
+***************************************************/
+
+/** number of size classes */
+#define BPSET_CLASS_NUM 4
+
+/** bytes per chunk and chunks per class, smallest class first */
+#define BPSET_CLASS0_BYTES  128
+#define BPSET_CLASS0_CHUNKS  32
+#define BPSET_CLASS1_BYTES  512
+#define BPSET_CLASS1_CHUNKS  16
+#define BPSET_CLASS2_BYTES 2048
+#define BPSET_CLASS2_CHUNKS   8
+#define BPSET_CLASS3_BYTES 8192
+#define BPSET_CLASS3_CHUNKS   4
+
+/***************************************************
+            DATA TYPES
+***************************************************/
+
+/** buffer pool set object */
+typedef struct {
+  bufferPool_d_t pools[BPSET_CLASS_NUM];  /* one pool per size class, ascending */
+} bufferPoolSet_t;
+
+#if APP_STATIC_ALLOC
+/** descriptors, data and free list of one class */
+#define BPSET_CLASS_STORAGE(n) \
+  chunk_d_t     chunks##n[BPSET_CLASS##n##_CHUNKS]; \
+  unsigned char arena##n[BPSET_CLASS##n##_CHUNKS * BPSET_CLASS##n##_BYTES] __attribute__ ((aligned (32))); \
+  unsigned char freeList##n[BPSET_CLASS##n##_CHUNKS * sizeof(chunk_d_t*)];
+
+/** static storage of a pool set, declared by its consumer */
+typedef struct {
+  BPSET_CLASS_STORAGE(0)
+  BPSET_CLASS_STORAGE(1)
+  BPSET_CLASS_STORAGE(2)
+  BPSET_CLASS_STORAGE(3)
+} bufferPoolSet_storage_t;
+#else
+/** no static storage with heap allocation */
+typedef void bufferPoolSet_storage_t;
+#endif
+
+
+/***************************************************
+            Access Methods
+***************************************************/
+
+/** Initialize all size classes
+ *
+ * Parameters:
+ * @param pThis   pointer to own object
+ * @param pStore  storage of all classes (APP_STATIC_ALLOC), NULL to
+ *                allocate from the heap (heap builds only)
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure.
+ */
+int bufferPoolSet_init(bufferPoolSet_t *pThis, bufferPoolSet_storage_t *pStore);
+
+/** Get a chunk of at least 'bytes' bytes
+ *   - smallest class that fits, larger ones if that class is empty
+ *
+ * Parameters:
+ * @param pThis    pointer to own object
+ * @param bytes    bytes needed
+ * @param ppChunk  chunk acquired (NULL if none)
+ *
+ * @return 1 on success, negative value on failure
+ */
+int bufferPool_acquire_size(bufferPoolSet_t *pThis, unsigned int bytes, chunk_d_t **ppChunk);
+
+/** Release a chunk to the class it came from
+ *
+ * Parameters:
+ * @param pThis   pointer to own object
+ * @param pChunk  chunk from bufferPool_acquire_size()
+ *
+ * @return 1 on success, negative value on failure
+ */
+int bufferPool_release_size(bufferPoolSet_t *pThis, chunk_d_t *pChunk);
+
+#endif
@@ -14,34 +14,35 @@
  *
  *******************************************************************************/
 #include <stdlib.h>
+#include <string.h>
 #include "bufferPool_d.h"
 #include "zedboard_freertos.h"
+#include "timeStamp.h"
 
 
 #define malloc(size) pvPortMalloc(size)
 
-/** Initialize buffer pool 
- *    - initialize freeList, populate with chunks
+/** Put all chunks on the (already created) free list
  *
  * Parameters:
- * @param pThis  pointer to buffer pool data structure
+ * @param pThis      pointer to buffer pool data structure
+ * @param numChunks  number of chunks
+ * @param chunkSize  bytes per chunk
+ * @param pChunks    chunk descriptors
+ * @param pArena     chunk data, numChunks * chunkSize bytes
  *
  * @return PASS/Zero on success.
  * FAIL/Negative value on failure.
  */
-int bufferPool_d_init(bufferPool_d_t *pThis, int numChunks, int chunkSize) {
+static int bufferPool_d_populate(bufferPool_d_t *pThis, int numChunks, int chunkSize,
+		chunk_d_t *pChunks, unsigned char *pArena) {
 	int count = 0;
 
 	pThis->bytesPerChunk = chunkSize;
+	pThis->buffer = pChunks;
+	pThis->pArena = pArena;
 
-	/* allocate memory for all chunk data structures*/
-	pThis->buffer = (chunk_d_t*) malloc(numChunks * sizeof(chunk_d_t));
-
-	// Init freelist queue
-	// Note: queue will contain pointer to chunk structure
-	pThis->freeList = xQueueCreate( numChunks, sizeof(chunk_d_t*) );
-
-	if (pThis->freeList == 0) {
+	if (pThis->freeList == 0 || NULL == pChunks || NULL == pArena) {
 		printf("[BP_d]: Failed to initialize free list\n");
 		return -1;
 	}
@@ -51,8 +52,8 @@ int bufferPool_d_init(bufferPool_d_t *pThis, int numChunks, int chunkSize) {
 		/* pointer to currently operated on chunk */
 		chunk_d_t *pChunk = &pThis->buffer[count];
 
-		/* allocate memory for data buffer for this chunk */
-		pChunk->u08_buff = malloc(chunkSize);
+		/* data buffer for this chunk */
+		pChunk->u08_buff = &pArena[count * chunkSize];
 
 		// init chunk
 		if (-1 == chunk_d_init(pChunk, chunkSize)) {
@@ -61,16 +62,130 @@ int bufferPool_d_init(bufferPool_d_t *pThis, int numChunks, int chunkSize) {
 		}
 
 		// put initialized chunk into queue
-		if(xQueueSend( pThis->freeList, &pChunk, NULL ) != pdPASS) {
+		if(xQueueSend( pThis->freeList, &pChunk, 0 ) != pdPASS) {
 			printf("Failed to put chunk %d/%d \n", count, numChunks);
 			return -1;
 		}
 	}
 
+	pThis->numChunks = numChunks;
+	bufferPool_d_resetStats(pThis);
+
 	printf("[BP_d]: Initialized\n");
 	return PASS;
 }
 
+/** Account a successful acquire
+ *
+ * Parameters:
+ * @param pThis   pointer to buffer pool data structure
+ * @param pChunk  chunk acquired
+ * @param free    chunks left on the free list
+ */
+static void bufferPool_d_acquired(bufferPool_d_t *pThis, chunk_d_t *pChunk, unsigned int free) {
+	pThis->stats.acquires++;
+	if (free < pThis->stats.minFree) {
+		pThis->stats.minFree = free;
+	}
+
+	/* declare that chunk is  empty */
+	pChunk->bytesMax  = pThis->bytesPerChunk;
+	pChunk->bytesUsed = 0;
+	pChunk->tAcquire  = timeStamp_get();
+	pChunk->streamId  = CHUNK_STREAM_NONE;
+	pChunk->format    = CHUNK_FMT_S16;
+	pChunk->channels  = 2; /* interleaved L,R FIFO stream */
+}
+
+/** Account the hold time of a released chunk
+ *
+ * Parameters:
+ * @param pThis   pointer to buffer pool data structure
+ * @param pChunk  chunk released
+ */
+static void bufferPool_d_released(bufferPool_d_t *pThis, chunk_d_t *pChunk) {
+	unsigned int held = (timeStamp_get() - pChunk->tAcquire) >> BP_HOLD_SHIFT;
+	unsigned int bin  = held ? 32 - __builtin_clz(held) : 0;
+
+	if (bin >= BP_HOLD_BINS) {
+		bin = BP_HOLD_BINS - 1;
+	}
+	pThis->stats.hold[bin]++;
+}
+
+/** Initialize buffer pool 
+ *    - initialize freeList, populate with chunks
+ *
+ * Parameters:
+ * @param pThis  pointer to buffer pool data structure
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure.
+ */
+int bufferPool_d_init(bufferPool_d_t *pThis, int numChunks, int chunkSize) {
+
+	// Init freelist queue
+	// Note: queue will contain pointer to chunk structure
+	pThis->freeList = xQueueCreate( numChunks, sizeof(chunk_d_t*) );
+	pThis->chunksMax  = numChunks;
+	pThis->arenaBytes = numChunks * chunkSize;
+
+	/* allocate memory for all chunk data structures and their data */
+	return bufferPool_d_populate(pThis, numChunks, chunkSize,
+			(chunk_d_t*) malloc(numChunks * sizeof(chunk_d_t)),
+			(unsigned char*) malloc(numChunks * chunkSize));
+}
+
+#if APP_STATIC_ALLOC
+/** Initialize buffer pool on caller provided (static) memory
+ *
+ * Parameters:
+ * @param pThis             pointer to buffer pool data structure
+ * @param numChunks         number of chunks
+ * @param chunkSize         bytes per chunk
+ * @param pChunks           numChunks chunk descriptors
+ * @param pArena            numChunks * chunkSize bytes of chunk data
+ * @param pFreeListStorage  numChunks * sizeof(chunk_d_t*) bytes for the free list
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure.
+ */
+int bufferPool_d_initStatic(bufferPool_d_t *pThis, int numChunks, int chunkSize,
+		chunk_d_t *pChunks, unsigned char *pArena, unsigned char *pFreeListStorage) {
+
+	pThis->freeList = xQueueCreateStatic( numChunks, sizeof(chunk_d_t*),
+			pFreeListStorage, &pThis->freeListBuf );
+	pThis->chunksMax  = numChunks;
+	pThis->arenaBytes = numChunks * chunkSize;
+
+	return bufferPool_d_populate(pThis, numChunks, chunkSize, pChunks, pArena);
+}
+#endif
+
+/** Re-divide the pool into a different number/size of chunks
+ *
+ * Parameters:
+ * @param pThis      pointer to buffer pool data structure
+ * @param numChunks  number of chunks
+ * @param chunkSize  bytes per chunk
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure.
+ */
+int bufferPool_d_reinit(bufferPool_d_t *pThis, int numChunks, int chunkSize) {
+	if (NULL == pThis || numChunks <= 0 || chunkSize <= 0
+			|| (unsigned int) numChunks > pThis->chunksMax
+			|| (unsigned int) (numChunks * chunkSize) > pThis->arenaBytes) {
+		printf("[BP_d]: %d x %d bytes does not fit the pool\n", numChunks, chunkSize);
+		return -1;
+	}
+
+	/* forget chunks still out, they belong to the old geometry */
+	xQueueReset(pThis->freeList);
+
+	return bufferPool_d_populate(pThis, numChunks, chunkSize, pThis->buffer, pThis->pArena);
+}
+
 /** Get a chunk from the  buffer pool 
  *
  * Parameters:
@@ -88,13 +203,13 @@ int bufferPool_d_acquire(bufferPool_d_t *pThis, chunk_d_t **ppChunk) {
 	}
 
 	if( !xQueueReceive( pThis->freeList, ppChunk, ( TickType_t ) 0)) {
-		//printf("[BP_d]: No free buffer pool samples avaialable\n");
+		/* counted instead of printed - this is hit on the audio path */
+		pThis->stats.failTask++;
+		pThis->stats.minFree = 0;
 		*ppChunk = NULL;
 		return -1;
 	}
-	/* declare that chunk is  empty */
-	(*ppChunk)->bytesMax  = pThis->bytesPerChunk;
-	(*ppChunk)->bytesUsed = 0;
+	bufferPool_d_acquired(pThis, *ppChunk, uxQueueMessagesWaiting(pThis->freeList));
 	return 1;
 }
 
@@ -106,13 +221,12 @@ int bufferPool_d_acquire_ISR(bufferPool_d_t *pThis, chunk_d_t **ppChunk ) {
 	}
 
 	if( !xQueueReceiveFromISR( pThis->freeList, ppChunk, NULL)) {
-		printf("[BP_d ISR]: No free buffer pool samples available\n");
+		pThis->stats.failIsr++;
+		pThis->stats.minFree = 0;
 		*ppChunk = NULL;
 		return -1;
 	}
-	/* declare that chunk is  empty */
-	(*ppChunk)->bytesMax  = pThis->bytesPerChunk;
-	(*ppChunk)->bytesUsed = 0;
+	bufferPool_d_acquired(pThis, *ppChunk, uxQueueMessagesWaitingFromISR(pThis->freeList));
 	return 1;
 }
 
@@ -129,10 +243,11 @@ int bufferPool_d_acquire_ISR(bufferPool_d_t *pThis, chunk_d_t **ppChunk ) {
  */
 int bufferPool_d_release(bufferPool_d_t *pThis, chunk_d_t *pChunk) {
 	if (NULL == pThis || NULL == pChunk) {
-		printf("[BP_d]: Acquire failed\n");
+		printf("[BP_d]: Release failed\n");
 		return -1;
 	}
 
+	bufferPool_d_released(pThis, pChunk);
 	if(xQueueSend( pThis->freeList, &pChunk, ( TickType_t ) 10 ) != pdPASS) {
 		printf("Error in releasing the chunk to the freelist\n");
 		pChunk = NULL;
@@ -154,11 +269,12 @@ int bufferPool_d_release(bufferPool_d_t *pThis, chunk_d_t *pChunk) {
  */
 int bufferPool_d_release_from_ISR(bufferPool_d_t *pThis, chunk_d_t *pChunk) {
 	if (NULL == pThis || NULL == pChunk) {
-		printf("[BP_d]: Acquire failed\n");
+		printf("[BP_d]: Release failed\n");
 		return -1;
 	}
 
-	if(xQueueSendFromISR( pThis->freeList, &pChunk, ( TickType_t ) 10 ) != pdPASS) {
+	bufferPool_d_released(pThis, pChunk);
+	if(xQueueSendFromISR( pThis->freeList, &pChunk, NULL ) != pdPASS) {
 		pChunk = NULL;
 		return -1;
 	}
@@ -172,17 +288,70 @@ int bufferPool_d_release_from_ISR(bufferPool_d_t *pThis, chunk_d_t *pChunk) {
  *
  * @return   true (non-zero) if emtpy, 0 if chunks available
  */
-int bufferPool_is_empty(bufferPool_d_t *pThis) {
+int bufferPool_d_is_empty(bufferPool_d_t *pThis) {
 	if (NULL == pThis) {
 		printf("[BP_d]: bufferPool_d_is_empty failed \n");
 		return -1;
 	}
 
-	if (pdFALSE != xQueueIsQueueEmptyFromISR(&pThis->freeList)) {
-		printf("[BP_d]: The buffer has free chunks \n");
-		return 0;
-	}
+	return (0 == uxQueueMessagesWaiting(pThis->freeList)) ? 1 : 0;
+}
 
-	return 1;
+/** Number of chunks on the free list
+ *
+ * Parameters:
+ * @param pThis  pointer to buffer pool data structure
+ *
+ * @return free chunks
+ */
+unsigned int bufferPool_d_free(bufferPool_d_t *pThis) {
+	return uxQueueMessagesWaiting(pThis->freeList);
+}
+
+/** Copy the pool statistics
+ *
+ * Parameters:
+ * @param pThis   pointer to buffer pool data structure
+ * @param pStats  destination
+ */
+void bufferPool_d_getStats(bufferPool_d_t *pThis, bufferPool_d_stats_t *pStats) {
+	taskENTER_CRITICAL();
+	*pStats = pThis->stats;
+	taskEXIT_CRITICAL();
+}
+
+/** Restart the statistics
+ *
+ * Parameters:
+ * @param pThis  pointer to buffer pool data structure
+ */
+void bufferPool_d_resetStats(bufferPool_d_t *pThis) {
+	taskENTER_CRITICAL();
+	memset(&pThis->stats, 0, sizeof(pThis->stats));
+	pThis->stats.minFree = uxQueueMessagesWaiting(pThis->freeList);
+	taskEXIT_CRITICAL();
+}
+
+/** Print the pool statistics
+ *
+ * Parameters:
+ * @param pThis  pointer to buffer pool data structure
+ * @param name   pool name for the output
+ */
+void bufferPool_d_printStats(bufferPool_d_t *pThis, const char *name) {
+	bufferPool_d_stats_t stats;
+	int bin;
+
+	bufferPool_d_getStats(pThis, &stats);
+
+	printf("[BP_d]: %s: %u x %u bytes, free %u, min free %u\n", name, pThis->numChunks,
+			pThis->bytesPerChunk, bufferPool_d_free(pThis), stats.minFree);
+	printf("[BP_d]: %s: acquires %u, failed task %u / ISR %u\n", name, stats.acquires,
+			stats.failTask, stats.failIsr);
+	printf("[BP_d]: %s: hold time histogram (bin n < 2^(%d+n) ticks):", name, BP_HOLD_SHIFT);
+	for (bin = 0; bin < BP_HOLD_BINS; bin++) {
+		printf(" %u", stats.hold[bin]);
+	}
+	printf("\n");
 }
 
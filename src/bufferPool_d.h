@@ -21,21 +21,50 @@
 //#include "isrDisp.h"
 #include "chunk_d.h"
 #include "zedboard_freertos.h"
+#include "appConfig.h"
 
 /***************************************************
             DEFINES
 ***************************************************/   
 
+/**
+ * @def BP_HOLD_BINS
+ * @brief hold time histogram bins: bin 0 is below 2^BP_HOLD_SHIFT time
+ *        stamp ticks (~100 us at 333 MHz), each further bin doubles,
+ *        the last one collects everything longer
+ */
+#define BP_HOLD_BINS  12
+#define BP_HOLD_SHIFT 15
 /***************************************************
             DATA TYPES
 ***************************************************/
 
+/** buffer pool statistics
+ *   - updated by tasks and ISRs without locking, an update may
+ *     occasionally be lost
+ */
+typedef struct {
+    unsigned int  minFree;       /* lowest free count since reset */
+    unsigned int  acquires;      /* successful acquires */
+    unsigned int  failTask;      /* acquire failures in task context */
+    unsigned int  failIsr;       /* acquire failures in ISR context */
+    unsigned int  hold[BP_HOLD_BINS]; /* acquire-to-release time histogram */
+} bufferPool_d_stats_t;
+
 /** bufferPool object
  */
 typedef struct {
 	QueueHandle_t freeList;
     chunk_d_t    *buffer;
     unsigned int  bytesPerChunk;
+    unsigned char *pArena;       /* chunk data */
+    unsigned int  chunksMax;     /* chunk descriptors / free list length */
+    unsigned int  arenaBytes;    /* size of pArena */
+    unsigned int  numChunks;     /* chunks currently in the pool */
+    bufferPool_d_stats_t stats;  /* telemetry */
+#if APP_STATIC_ALLOC
+    StaticQueue_t freeListBuf; /* free list control block */
+#endif
 } bufferPool_d_t;
 
 
@@ -54,6 +83,39 @@ typedef struct {
  */
 int bufferPool_d_init(bufferPool_d_t *pThis, int numChunks, int chunkSize);
 
+#if APP_STATIC_ALLOC
+/** Initialize buffer pool on caller provided (static) memory
+ *    - no heap allocation
+ *
+ * Parameters:
+ * @param pThis             pointer to buffer pool
+ * @param numChunks         number of chunks
+ * @param chunkSize         bytes per chunk
+ * @param pChunks           numChunks chunk descriptors
+ * @param pArena            numChunks * chunkSize bytes of chunk data
+ * @param pFreeListStorage  numChunks * sizeof(chunk_d_t*) bytes for the free list
+ *
+ * @return Zero on success.
+ * Negative value on failure.
+ */
+int bufferPool_d_initStatic(bufferPool_d_t *pThis, int numChunks, int chunkSize,
+		chunk_d_t *pChunks, unsigned char *pArena, unsigned char *pFreeListStorage);
+#endif
+
+
+/** Re-divide the pool into a different number/size of chunks
+ *    - reuses the descriptors, arena and free list of the initial geometry
+ *    - all chunks must have been returned (or be abandoned) by the caller
+ *
+ * Parameters:
+ * @param pThis      pointer to buffer pool
+ * @param numChunks  number of chunks (at most the initial number)
+ * @param chunkSize  bytes per chunk (numChunks * chunkSize must fit the arena)
+ *
+ * @return Zero on success.
+ * Negative value on failure.
+ */
+int bufferPool_d_reinit(bufferPool_d_t *pThis, int numChunks, int chunkSize);
 
 /** Get a chunk from the  buffer pool 
  *
@@ -102,4 +164,36 @@ int bufferPool_d_release_from_ISR(bufferPool_d_t *pThis, chunk_d_t *pChunk);
  */
 int bufferPool_d_is_empty(bufferPool_d_t *pThis );
 
+/** Number of chunks on the free list
+ *
+ * Parameters:
+ * @param pThis  pointer to buffer pool
+ *
+ * @return free chunks
+ */
+unsigned int bufferPool_d_free(bufferPool_d_t *pThis);
+
+/** Copy the pool statistics
+ *
+ * Parameters:
+ * @param pThis   pointer to buffer pool
+ * @param pStats  destination
+ */
+void bufferPool_d_getStats(bufferPool_d_t *pThis, bufferPool_d_stats_t *pStats);
+
+/** Restart the statistics (minimum free = current free)
+ *
+ * Parameters:
+ * @param pThis  pointer to buffer pool
+ */
+void bufferPool_d_resetStats(bufferPool_d_t *pThis);
+
+/** Print the pool statistics
+ *
+ * Parameters:
+ * @param pThis  pointer to buffer pool
+ * @param name   pool name for the output
+ */
+void bufferPool_d_printStats(bufferPool_d_t *pThis, const char *name);
+
 #endif
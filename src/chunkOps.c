@@ -0,0 +1,201 @@
+/**
+ *@file chunkOps.c
+ *
+ *@brief
+ *  - chunk data kernels: copy, convert with gain, interleave
+ *
+ * All conversions run through float: a sample is loaded, scaled by
+ * gain * (destination full scale / source full scale) and stored with
+ * saturation, 8 samples per NEON iteration.
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#include <string.h>
+#include "chunkOps.h"
+#include "zedboard_freertos.h"
+
+#ifdef __ARM_NEON__
+#include <arm_neon.h>
+#endif
+
+/* prefetch distance: 4 cache lines (Cortex-A9 L1 line = 32 bytes) */
+#define CHUNKOPS_PREFETCH_BYTES 128
+
+/* full scale per format */
+static const float chunkOps_fullScale[CHUNK_FMT_NUM] = { 32768.0f, 8388608.0f, 1.0f };
+
+/* bytes per sample in memory */
+#define SZ_S16 2
+#define SZ_S24 4
+#define SZ_F32 4
+
+#define S24_MAX  8388607
+#define S24_MIN (-8388608)
+
+/* ---- scalar load/store, one sample ---- */
+
+static inline float ld1_S16(const void *p, unsigned int i) { return ((const short *) p)[i]; }
+static inline float ld1_S24(const void *p, unsigned int i) { return ((const int *) p)[i]; }
+static inline float ld1_F32(const void *p, unsigned int i) { return ((const float *) p)[i]; }
+
+static inline void st1_S16(void *p, unsigned int i, float v)
+{
+	((short *) p)[i] = (v >= 32767.0f) ? 32767 : (v <= -32768.0f) ? -32768 : (short) v;
+}
+static inline void st1_S24(void *p, unsigned int i, float v)
+{
+	((int *) p)[i] = (v >= (float) S24_MAX) ? S24_MAX : (v <= (float) S24_MIN) ? S24_MIN : (int) v;
+}
+static inline void st1_F32(void *p, unsigned int i, float v) { ((float *) p)[i] = v; }
+
+#ifdef __ARM_NEON__
+/* ---- NEON load/store, four samples ---- */
+
+static inline float32x4_t ld4_S16(const void *p, unsigned int i) { return vcvtq_f32_s32(vmovl_s16(vld1_s16((const short *) p + i))); }
+static inline float32x4_t ld4_S24(const void *p, unsigned int i) { return vcvtq_f32_s32(vld1q_s32((const int *) p + i)); }
+static inline float32x4_t ld4_F32(const void *p, unsigned int i) { return vld1q_f32((const float *) p + i); }
+
+/* vcvtq_s32_f32 rounds toward zero and saturates */
+static inline void st4_S16(void *p, unsigned int i, float32x4_t v) { vst1_s16((short *) p + i, vqmovn_s32(vcvtq_s32_f32(v))); }
+static inline void st4_S24(void *p, unsigned int i, float32x4_t v)
+{
+	int32x4_t x = vcvtq_s32_f32(v);
+	x = vminq_s32(vmaxq_s32(x, vdupq_n_s32(S24_MIN)), vdupq_n_s32(S24_MAX));
+	vst1q_s32((int *) p + i, x);
+}
+static inline void st4_F32(void *p, unsigned int i, float32x4_t v) { vst1q_f32((float *) p + i, v); }
+
+#define CHUNKOPS_NEON_LOOP(SRC, DST) \
+	for (; i + 8 <= n; i += 8) { \
+		__builtin_prefetch((const char *) pSrc + i * SZ_##SRC + CHUNKOPS_PREFETCH_BYTES); \
+		st4_##DST(pDst, i,     vmulq_n_f32(ld4_##SRC(pSrc, i),     scale)); \
+		st4_##DST(pDst, i + 4, vmulq_n_f32(ld4_##SRC(pSrc, i + 4), scale)); \
+	}
+#else
+#define CHUNKOPS_NEON_LOOP(SRC, DST)
+#endif
+
+/** one fused load-scale-store kernel per format pair */
+#define CHUNKOPS_KERNEL(SRC, DST) \
+static void chunkOps_##SRC##_to_##DST(void *pDst, const void *pSrc, unsigned int n, float scale) \
+{ \
+	unsigned int i = 0; \
+	CHUNKOPS_NEON_LOOP(SRC, DST) \
+	for (; i < n; i++) { \
+		st1_##DST(pDst, i, ld1_##SRC(pSrc, i) * scale); \
+	} \
+}
+
+CHUNKOPS_KERNEL(S16, S16)
+CHUNKOPS_KERNEL(S16, S24)
+CHUNKOPS_KERNEL(S16, F32)
+CHUNKOPS_KERNEL(S24, S16)
+CHUNKOPS_KERNEL(S24, S24)
+CHUNKOPS_KERNEL(S24, F32)
+CHUNKOPS_KERNEL(F32, S16)
+CHUNKOPS_KERNEL(F32, S24)
+CHUNKOPS_KERNEL(F32, F32)
+
+typedef void (*chunkOps_kernel_t)(void *pDst, const void *pSrc, unsigned int n, float scale);
+
+/* [source format][destination format] */
+static const chunkOps_kernel_t chunkOps_kernels[CHUNK_FMT_NUM][CHUNK_FMT_NUM] = {
+	{ chunkOps_S16_to_S16, chunkOps_S16_to_S24, chunkOps_S16_to_F32 },
+	{ chunkOps_S24_to_S16, chunkOps_S24_to_S24, chunkOps_S24_to_F32 },
+	{ chunkOps_F32_to_S16, chunkOps_F32_to_S24, chunkOps_F32_to_F32 },
+};
+
+/* Copy raw bytes */
+void chunkOps_copy(void *pDst, const void *pSrc, unsigned int bytes)
+{
+	unsigned char *pD = (unsigned char *) pDst;
+	const unsigned char *pS = (const unsigned char *) pSrc;
+	unsigned int i = 0;
+
+#ifdef __ARM_NEON__
+	/* two cache lines per iteration */
+	for (; i + 64 <= bytes; i += 64) {
+		uint8x16_t a, b, c, d;
+
+		__builtin_prefetch(&pS[i + CHUNKOPS_PREFETCH_BYTES]);
+		__builtin_prefetch(&pS[i + CHUNKOPS_PREFETCH_BYTES + 32]);
+		a = vld1q_u8(&pS[i]);
+		b = vld1q_u8(&pS[i + 16]);
+		c = vld1q_u8(&pS[i + 32]);
+		d = vld1q_u8(&pS[i + 48]);
+		vst1q_u8(&pD[i],      a);
+		vst1q_u8(&pD[i + 16], b);
+		vst1q_u8(&pD[i + 32], c);
+		vst1q_u8(&pD[i + 48], d);
+	}
+#endif
+
+	memcpy(&pD[i], &pS[i], bytes - i);
+}
+
+/* Copy with format conversion and gain */
+int chunkOps_convert(chunk_d_t *pDst, const chunk_d_t *pSrc, int gainQ15)
+{
+	unsigned int n = pSrc->bytesUsed / sizeof(unsigned int);
+	float scale;
+
+	if (pSrc->format >= CHUNK_FMT_NUM || pDst->format >= CHUNK_FMT_NUM
+			|| pSrc->bytesUsed > pDst->bytesMax) {
+		return -1;
+	}
+
+	scale = ((float) gainQ15 / CHUNKOPS_GAIN_UNITY)
+			* chunkOps_fullScale[pDst->format] / chunkOps_fullScale[pSrc->format];
+
+	chunkOps_kernels[pSrc->format][pDst->format](pDst->u32_buff, pSrc->u32_buff, n, scale);
+
+	pDst->bytesUsed = pSrc->bytesUsed;
+	pDst->seq       = pSrc->seq;
+	pDst->tCapture  = pSrc->tCapture;
+	pDst->streamId  = pSrc->streamId;
+	pDst->channels  = pSrc->channels;
+	return PASS;
+}
+
+/* Interleave two mono S16 chunks */
+int chunkOps_interleave(chunk_d_t *pDst, const chunk_d_t *pLeft, const chunk_d_t *pRight)
+{
+	const short *pL = pLeft->s16_buff;
+	const short *pR = pRight->s16_buff;
+	short *pD = pDst->s16_buff;
+	unsigned int n = ((pLeft->bytesUsed < pRight->bytesUsed) ? pLeft->bytesUsed : pRight->bytesUsed)
+			/ sizeof(unsigned int);
+	unsigned int i = 0;
+
+	if ((int) (2 * n * sizeof(unsigned int)) > pDst->bytesMax) {
+		return -1;
+	}
+
+#ifdef __ARM_NEON__
+	for (; i + 8 <= n; i += 8) {
+		int16x8x2_t lr;
+
+		__builtin_prefetch(&pL[i + CHUNKOPS_PREFETCH_BYTES / SZ_S16]);
+		__builtin_prefetch(&pR[i + CHUNKOPS_PREFETCH_BYTES / SZ_S16]);
+		lr.val[0] = vld1q_s16(&pL[i]);
+		lr.val[1] = vld1q_s16(&pR[i]);
+		vst2q_s16(&pD[2 * i], lr);
+	}
+#endif
+
+	for (; i < n; i++) {
+		pD[2 * i]     = pL[i];
+		pD[2 * i + 1] = pR[i];
+	}
+
+	chunk_d_copyMeta(pLeft, pDst);
+	pDst->format    = CHUNK_FMT_S16;
+	pDst->channels  = 2;
+	pDst->bytesUsed = 2 * n * sizeof(unsigned int);
+	return PASS;
+}
@@ -0,0 +1,76 @@
+/**
+ *@file chunkOps.h
+ *
+ *@brief
+ *  - chunk data kernels: copy, copy with format conversion and gain,
+ *    mono to stereo interleave
+ *  - conversion and gain are fused into the copy, so the data passes
+ *    through the cache once
+ *  - NEON with cache line prefetch when built with -mfpu=neon,
+ *    plain C otherwise
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#ifndef _CHUNK_OPS_H_
+#define _CHUNK_OPS_H_
+
+#include "chunk_d.h"
+
+/***************************************************
+            DEFINES
+***************************************************/
+
+/**
+ * @def CHUNKOPS_GAIN_UNITY
+ * @brief gain of 1.0 for chunkOps_convert (Q15, one above the short range)
+ */
+#define CHUNKOPS_GAIN_UNITY 0x8000
+
+/***************************************************
+            Access Methods
+***************************************************/
+
+/** Copy raw bytes (NEON, 64 bytes per iteration)
+ *
+ * Parameters:
+ * @param pDst   destination
+ * @param pSrc   source
+ * @param bytes  number of bytes
+ */
+void chunkOps_copy(void *pDst, const void *pSrc, unsigned int bytes);
+
+/** Copy a chunk converting to the destination format with a gain
+ *   - kernel picked by pSrc->format and pDst->format
+ *   - float to integer rounds toward zero and saturates
+ *   - metadata is copied, pDst keeps its own format
+ *   - pDst and pSrc must not share data
+ *
+ * Parameters:
+ * @param pDst     destination chunk, format set by the caller
+ * @param pSrc     source chunk
+ * @param gainQ15  gain, CHUNKOPS_GAIN_UNITY = 1.0
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value if the data does not fit pDst
+ */
+int chunkOps_convert(chunk_d_t *pDst, const chunk_d_t *pSrc, int gainQ15);
+
+/** Interleave two mono S16 chunks into one stereo S16 chunk
+ *   - length of the shorter input
+ *
+ * Parameters:
+ * @param pDst    destination chunk
+ * @param pLeft   left channel
+ * @param pRight  right channel
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value if the data does not fit pDst
+ */
+int chunkOps_interleave(chunk_d_t *pDst, const chunk_d_t *pLeft, const chunk_d_t *pRight);
+
+#endif
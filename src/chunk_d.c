@@ -17,6 +17,7 @@
  *
  *******************************************************************************/
 #include "chunk_d.h"
+#include "chunkOps.h"
 #include <stdio.h>
 
 /** Initialize buffer chunk
@@ -35,6 +36,8 @@ int chunk_d_init(chunk_d_t *pThis, int chunkSize) {
 
 	pThis->bytesMax  = chunkSize;
 	pThis->bytesUsed = 0; // default not filled
+	pThis->format    = CHUNK_FMT_S16;
+	pThis->channels  = 2; /* interleaved L,R FIFO stream */
 	return 1;
 }
 
@@ -45,17 +48,24 @@ int chunk_d_init(chunk_d_t *pThis, int chunkSize) {
  *@return PASS/0 success, non-zero otherwise
  **/
 int chunk_d_copy(chunk_d_t *pSrc, chunk_d_t *pDst) {
-	unsigned int count;
-	unsigned int len = pSrc->bytesUsed / 4;
-
-	// manual copy still in place from previous architecture.
-	// can probably be replaced with memcpy
-	for (count = 0; len > count; count++) {
-		pDst->u32_buff[count] = pSrc->u32_buff[count];
-	}
+	// NEON block copy with prefetch
+	chunkOps_copy(pDst->u32_buff, pSrc->u32_buff, pSrc->bytesUsed);
 	// update length of actual copied data
 	pDst->bytesUsed = pSrc->bytesUsed;
+	chunk_d_copyMeta(pSrc, pDst);
 
 	return 1;
 }
 
+/** copy sequence number, capture time, stream ID and format
+ *@param pSrc  pointer to source object (will not be modified)
+ *@param pDst  pointer to destination object
+ **/
+void chunk_d_copyMeta(const chunk_d_t *pSrc, chunk_d_t *pDst) {
+	pDst->seq      = pSrc->seq;
+	pDst->tCapture = pSrc->tCapture;
+	pDst->streamId = pSrc->streamId;
+	pDst->format   = pSrc->format;
+	pDst->channels = pSrc->channels;
+}
+
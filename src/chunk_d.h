@@ -32,6 +32,20 @@ typedef enum {
 /** free */
 } e_buff_status_d_t;
 
+/** Chunk stream IDs (origin of the samples) */
+#define CHUNK_STREAM_NONE 0 /** not set */
+#define CHUNK_STREAM_RX   1 /** codec input */
+#define CHUNK_STREAM_CLIP 2 /** sample bank clip */
+#define CHUNK_STREAM_FILE 3 /** streamed file */
+#define CHUNK_STREAM_MIX  4 /** mixer output (timing of the RX chunk it was made from) */
+
+/** Chunk sample formats, every sample takes one 32 bit slot of bytesUsed
+ *  (samples = bytesUsed / 4), stereo is interleaved L,R */
+#define CHUNK_FMT_S16 0 /** 16 bit, packed at the start of the buffer (RX/TX FIFO layout) */
+#define CHUNK_FMT_S24 1 /** 24 bit right aligned in 32 bit words */
+#define CHUNK_FMT_F32 2 /** float, full scale +-1.0 */
+#define CHUNK_FMT_NUM 3
+
 /** Chunk Object
  */
 typedef struct {
@@ -47,6 +61,12 @@ typedef struct {
 	int bytesMax; /** total number bytes in chunk */
 	int bytesUsed; /** used bytes in chunk (fill level) */
 	e_buff_status_d_t e_status; /** status */
+	unsigned int tAcquire; /** time stamp of acquire (pool hold time statistics) */
+	unsigned int seq; /** sequence number within the stream */
+	unsigned int tCapture; /** time stamp of capture (RX ISR) or creation */
+	unsigned int streamId; /** CHUNK_STREAM_xxx */
+	unsigned char format; /** CHUNK_FMT_xxx */
+	unsigned char channels; /** 1 = mono, 2 = interleaved stereo */
 
 } chunk_d_t;
 
@@ -68,4 +88,10 @@ int chunk_d_init(chunk_d_t *pThis, int chunkSize);
  **/
 int chunk_d_copy(chunk_d_t *pSrc, chunk_d_t *pDst);
 
+/** copy sequence number, capture time, stream ID and format
+ *@param pSrc  pointer to source object (will not be modified)
+ *@param pDst  pointer to destination object
+ **/
+void chunk_d_copyMeta(const chunk_d_t *pSrc, chunk_d_t *pDst);
+
 #endif
@@ -0,0 +1,356 @@
+/**
+ *@file crossover.c
+ *
+ *@brief
+ *  - Linkwitz-Riley crossover, band split of an interleaved stereo chunk
+ *
+ * Band tree for split frequencies f0 < f1 < f2 (LR4 = two Butterworth
+ * biquads, AP = LR4 low + high = 2nd order allpass at the same frequency):
+ *   band 0 = LP(f0) AP(f1) AP(f2)
+ *   band 1 = HP(f0) LP(f1) AP(f2)
+ *   band 2 = HP(f0) HP(f1) LP(f2)
+ *   band 3 = HP(f0) HP(f1) HP(f2)
+ * The high passes are run once on a shared buffer, each band copies it
+ * before its own sections.
+ *
+ * Low band decimation: each half-band stage halves the rate (15 taps,
+ * 4 multiplies per output, -72 dB alias rejection for the lower quarter
+ * of its output band). The low band sections and its delay run at the
+ * reduced rate, the same stages interpolate back; allpasses of splits
+ * above a quarter of the reduced rate follow at the full rate. A stage pair delays by
+ * CROSSOVER_HB_DELAY samples at its input rate, the other bands get that
+ * delay added so the bands stay aligned.
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#include <string.h>
+#include "crossover.h"
+#include "dspMath.h"
+#include "zedboard_freertos.h"
+
+/* half-band taps at odd offsets 1, 3, 5, 7 from the center (0.5), equiripple
+ * for a pass band up to 1/8 of the input rate */
+static const float crossover_hbCoeff[CROSSOVER_HB_TAPS] = {
+	0.305371396f, -0.072324682f, 0.020571871f, -0.003738350f
+};
+
+#define CROSSOVER_HB_CENTER (2 * CROSSOVER_HB_TAPS - 1)
+
+/* decimator + interpolator delay at the stage input rate */
+#define CROSSOVER_HB_DELAY  (2 * CROSSOVER_HB_CENTER - 1)
+
+/* low band resolved up to 4 x f0 inside the last stage's pass band */
+#define CROSSOVER_DECIM_MARGIN 32
+
+/* low band allpasses up to a quarter of the reduced rate run decimated */
+#define CROSSOVER_AP_MARGIN    4
+
+/* biquad types */
+#define CROSSOVER_LP 0
+#define CROSSOVER_HP 1
+#define CROSSOVER_AP 2
+
+/* RBJ biquad with Q = 1/sqrt(2) (Butterworth, LR4 allpass) */
+static void crossover_design(crossover_biquad_t *pQ, unsigned int type, double freq, double rate)
+{
+	double s, c, alpha, a0;
+
+	dspMath_sinCos(2.0 * DSPMATH_PI * freq / rate, &s, &c);
+	alpha = s * 0.70710678118654752;
+	a0    = 1.0 + alpha;
+
+	switch (type) {
+	case CROSSOVER_LP:
+		pQ->b0 = (float) ((1.0 - c) * 0.5 / a0);
+		pQ->b1 = (float) ((1.0 - c) / a0);
+		pQ->b2 = pQ->b0;
+		break;
+	case CROSSOVER_HP:
+		pQ->b0 = (float) ((1.0 + c) * 0.5 / a0);
+		pQ->b1 = (float) (-(1.0 + c) / a0);
+		pQ->b2 = pQ->b0;
+		break;
+	default:
+		pQ->b0 = (float) ((1.0 - alpha) / a0);
+		pQ->b1 = (float) (-2.0 * c / a0);
+		pQ->b2 = 1.0f;
+		break;
+	}
+	pQ->a1 = (float) (-2.0 * c / a0);
+	pQ->a2 = (float) ((1.0 - alpha) / a0);
+	pQ->z1 = pQ->z2 = 0.0f;
+}
+
+static void crossover_biquadRun(crossover_biquad_t *pQ, float *pX, unsigned int n)
+{
+	float b0 = pQ->b0, b1 = pQ->b1, b2 = pQ->b2, a1 = pQ->a1, a2 = pQ->a2;
+	float z1 = pQ->z1, z2 = pQ->z2;
+	unsigned int i;
+
+	for (i = 0; i < n; i++) {
+		float x = pX[i];
+		float y = b0 * x + z1;
+
+		z1 = b1 * x - a1 * y + z2;
+		z2 = b2 * x - a2 * y;
+		pX[i] = y;
+	}
+	pQ->z1 = z1;
+	pQ->z2 = z2;
+}
+
+static inline const float *crossover_hbPush(crossover_hb_t *pH, float x)
+{
+	pH->pos = (pH->pos ? pH->pos : CROSSOVER_HB_LEN) - 1;
+	pH->hist[pH->pos] = pH->hist[pH->pos + CROSSOVER_HB_LEN] = x;
+	return &pH->hist[pH->pos];  /* [k] = k samples back */
+}
+
+/* n inputs -> n/2 outputs, may run in place */
+static unsigned int crossover_decimate(crossover_hb_t *pH, const float *pIn, float *pOut, unsigned int n)
+{
+	unsigned int p, m;
+
+	for (p = 0; p < n / 2; p++) {
+		const float *w;
+		float y;
+
+		crossover_hbPush(pH, pIn[2 * p]);
+		w = crossover_hbPush(pH, pIn[2 * p + 1]);
+		y = 0.5f * w[CROSSOVER_HB_CENTER];
+		for (m = 0; m < CROSSOVER_HB_TAPS; m++) {
+			y += crossover_hbCoeff[m] * (w[CROSSOVER_HB_CENTER - 1 - 2 * m] + w[CROSSOVER_HB_CENTER + 1 + 2 * m]);
+		}
+		pOut[p] = y;
+	}
+	return n / 2;
+}
+
+/* n inputs -> 2n outputs (zero stuffing, gain 2), not in place */
+static unsigned int crossover_interpolate(crossover_hb_t *pH, const float *pIn, float *pOut, unsigned int n)
+{
+	unsigned int q, m;
+
+	for (q = 0; q < n; q++) {
+		const float *w = crossover_hbPush(pH, pIn[q]);
+		float y = 0.0f;
+
+		for (m = 0; m < CROSSOVER_HB_TAPS; m++) {
+			y += crossover_hbCoeff[m] * (w[CROSSOVER_HB_TAPS - 1 - m] + w[CROSSOVER_HB_TAPS + m]);
+		}
+		pOut[2 * q]     = 2.0f * y;
+		pOut[2 * q + 1] = w[CROSSOVER_HB_TAPS - 1];
+	}
+	return 2 * n;
+}
+
+static void crossover_delay(crossover_band_t *pB, float *pX, unsigned int n)
+{
+	unsigned int i, pos = pB->ringPos;
+
+	for (i = 0; i < n; i++) {
+		pB->ring[pos] = pX[i];
+		pX[i] = pB->ring[(pos - pB->delay) & (CROSSOVER_RING - 1)];
+		pos = (pos + 1) & (CROSSOVER_RING - 1);
+	}
+	pB->ringPos = pos;
+}
+
+/* band 0 at the reduced rate, result in its buffer at the full rate */
+static void crossover_lowBand(crossover_t *pThis, const float *pIn, unsigned int n)
+{
+	crossover_band_t *pB = &pThis->band[0];
+	float *pA = pB->buf, *pT = pThis->scratch, *pSwap;
+	unsigned int s;
+
+	n = crossover_decimate(&pThis->decim[0], pIn, pA, n);
+	for (s = 1; s < pThis->stages; s++) {
+		n = crossover_decimate(&pThis->decim[s], pA, pA, n);
+	}
+
+	for (s = 0; s < pB->numDecim; s++) {
+		crossover_biquadRun(&pB->sect[s], pA, n);
+	}
+	crossover_delay(pB, pA, n);
+
+	for (s = pThis->stages; s-- > 0; ) {
+		n = crossover_interpolate(&pThis->interp[s], pA, pT, n);
+		pSwap = pA;
+		pA    = pT;
+		pT    = pSwap;
+	}
+	if (pA != pB->buf) {
+		memcpy(pB->buf, pA, n * sizeof(float));
+	}
+
+	/* allpasses of high splits, above the reduced rate */
+	for (s = pB->numDecim; s < pB->numSect; s++) {
+		crossover_biquadRun(&pB->sect[s], pB->buf, n);
+	}
+}
+
+/* Initialize the crossover */
+int crossover_init(crossover_t *pThis, unsigned int ways, const unsigned int *pFreqs,
+		unsigned int sampleRate)
+{
+	unsigned int b, j;
+	double lowRate;
+
+	if (ways < CROSSOVER_WAYS_MIN || ways > CROSSOVER_WAYS_MAX) {
+		printf("[XO]: %u ways not supported\r\n", ways);
+		return FAIL;
+	}
+	for (j = 0; j < ways - 1; j++) {
+		if (0 == pFreqs[j] || 2 * pFreqs[j] >= sampleRate || (j && pFreqs[j] <= pFreqs[j - 1])) {
+			printf("[XO]: invalid crossover frequency %u Hz\r\n", pFreqs[j]);
+			return FAIL;
+		}
+	}
+
+	memset(pThis, 0, sizeof(*pThis));
+	pThis->ways       = ways;
+	pThis->sampleRate = sampleRate;
+
+	/* as many half-band stages as the lowest split allows */
+	while (pThis->stages < CROSSOVER_DECIM_STAGES_MAX
+			&& pFreqs[0] * CROSSOVER_DECIM_MARGIN <= (sampleRate >> pThis->stages)) {
+		pThis->stages++;
+	}
+	pThis->latency = CROSSOVER_HB_DELAY * ((1u << pThis->stages) - 1);
+	lowRate = (double) sampleRate / (1u << pThis->stages);
+
+	/* high passes of the splits (shared) */
+	for (j = 0; j < ways - 1; j++) {
+		crossover_design(&pThis->hp[j][0], CROSSOVER_HP, pFreqs[j], sampleRate);
+		crossover_design(&pThis->hp[j][1], CROSSOVER_HP, pFreqs[j], sampleRate);
+	}
+
+	/* own low pass and the allpasses of the splits above */
+	for (b = 0; b < ways; b++) {
+		crossover_band_t *pB = &pThis->band[b];
+		double rate = (0 == b) ? lowRate : (double) sampleRate;
+
+		if (b < ways - 1) {
+			crossover_design(&pB->sect[pB->numSect++], CROSSOVER_LP, pFreqs[b], rate);
+			crossover_design(&pB->sect[pB->numSect++], CROSSOVER_LP, pFreqs[b], rate);
+		}
+		for (j = b + 1; j < ways - 1; j++) {
+			/* low band: allpasses too high for the reduced rate follow at the full rate */
+			if (rate < sampleRate && pFreqs[j] * CROSSOVER_AP_MARGIN > rate) {
+				rate = sampleRate;
+				pB->numDecim = pB->numSect;
+			}
+			crossover_design(&pB->sect[pB->numSect++], CROSSOVER_AP, pFreqs[j], rate);
+		}
+		if (rate < sampleRate) {
+			pB->numDecim = pB->numSect;
+		}
+
+		crossover_setBand(pThis, b, (0 == b) ? CROSSOVER_OUT_L : CROSSOVER_OUT_R, 0);
+	}
+
+	return PASS;
+}
+
+/* Set routing and delay of a band */
+int crossover_setBand(crossover_t *pThis, unsigned int band, unsigned int outMask,
+		unsigned int delayUs)
+{
+	crossover_band_t *pB;
+	unsigned int samples;
+
+	if (band >= pThis->ways) {
+		return FAIL;
+	}
+	samples = (unsigned int) (((uint64_t) delayUs * pThis->sampleRate + 500000) / 1000000);
+	if (samples > CROSSOVER_DELAY_MAX) {
+		printf("[XO]: band %u delay %u us too long\r\n", band, delayUs);
+		return FAIL;
+	}
+
+	pB = &pThis->band[band];
+	pB->outMask = outMask & (CROSSOVER_OUT_L | CROSSOVER_OUT_R);
+	if (0 == band && pThis->stages) {
+		/* low band: delay at its own rate, the others absorb the latency */
+		pB->delay = (samples + (1u << pThis->stages) / 2) >> pThis->stages;
+	} else {
+		pB->delay = samples + pThis->latency;
+	}
+	return PASS;
+}
+
+static inline short crossover_sat(float v)
+{
+	return (v >= 32767.0f) ? 32767 : (v <= -32768.0f) ? -32768 : (short) v;
+}
+
+/* Split an interleaved stereo S16 chunk in place */
+int crossover_process(crossover_t *pThis, chunk_d_t *pChunk)
+{
+	short *p = pChunk->s16_buff;
+	unsigned int slots = pChunk->bytesUsed / sizeof(unsigned int);
+	unsigned int n = slots / 2;
+	float *pL = pThis->scratch, *pR = pThis->high;
+	unsigned int b, i;
+
+	/* a half frame would shift L/R of every later chunk */
+	if (CHUNK_FMT_S16 != pChunk->format || 2 != pChunk->channels || (slots & 1) || n > CROSSOVER_FRAMES_MAX
+			|| (n & ((1u << pThis->stages) - 1))) {
+		return FAIL;
+	}
+
+	/* split L+R */
+	for (i = 0; i < n; i++) {
+		pThis->high[i] = 0.5f * ((float) p[2 * i] + (float) p[2 * i + 1]);
+	}
+	for (b = 0; b < pThis->ways; b++) {
+		crossover_band_t *pB = &pThis->band[b];
+		unsigned int s;
+
+		if (0 == b && pThis->stages) {
+			crossover_lowBand(pThis, pThis->high, n);
+		} else {
+			memcpy(pB->buf, pThis->high, n * sizeof(float));
+			for (s = 0; s < pB->numSect; s++) {
+				crossover_biquadRun(&pB->sect[s], pB->buf, n);
+			}
+			crossover_delay(pB, pB->buf, n);
+		}
+
+		/* what is left above this split */
+		if (b < pThis->ways - 1) {
+			crossover_biquadRun(&pThis->hp[b][0], pThis->high, n);
+			crossover_biquadRun(&pThis->hp[b][1], pThis->high, n);
+		}
+	}
+
+	/* sum the bands per channel (scratch and high are free now) */
+	memset(pL, 0, n * sizeof(float));
+	memset(pR, 0, n * sizeof(float));
+	for (b = 0; b < pThis->ways; b++) {
+		const crossover_band_t *pB = &pThis->band[b];
+
+		if (pB->outMask & CROSSOVER_OUT_L) {
+			for (i = 0; i < n; i++) {
+				pL[i] += pB->buf[i];
+			}
+		}
+		if (pB->outMask & CROSSOVER_OUT_R) {
+			for (i = 0; i < n; i++) {
+				pR[i] += pB->buf[i];
+			}
+		}
+	}
+
+	/* pack: even slots left, odd slots right */
+	for (i = 0; i < n; i++) {
+		p[2 * i]     = crossover_sat(pL[i]);
+		p[2 * i + 1] = crossover_sat(pR[i]);
+	}
+	return PASS;
+}
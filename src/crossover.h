@@ -0,0 +1,147 @@
+/**
+ *@file crossover.h
+ *
+ *@brief
+ *  - Linkwitz-Riley (LR4) crossover for bi-amp outputs: 2, 3 or 4 bands
+ *  - the bands sum to an allpass (lower bands carry the allpasses of the
+ *    splits above them)
+ *  - the low band runs decimated by half-band stages when its crossover
+ *    frequency is low enough, the other bands are delayed by the
+ *    decimation latency
+ *  - per band delay and routing to the left/right I2S channel of the
+ *    interleaved TX chunk
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#ifndef _CROSSOVER_H_
+#define _CROSSOVER_H_
+
+#include "chunk_d.h"
+
+/***************************************************
+            DEFINES
+***************************************************/
+
+/** bands */
+#define CROSSOVER_WAYS_MIN    2
+#define CROSSOVER_WAYS_MAX    4
+
+/** frames (L,R sample pairs) per chunk */
+#define CROSSOVER_FRAMES_MAX  512
+
+/** largest band delay (samples at the full rate, 10.7 ms at 48 kHz) */
+#define CROSSOVER_DELAY_MAX   512
+
+/** low band decimation: half-band stages (2, 4, 8 times) */
+#define CROSSOVER_DECIM_STAGES_MAX 3
+
+/** band output channels */
+#define CROSSOVER_OUT_L       (1 << 0)
+#define CROSSOVER_OUT_R       (1 << 1)
+
+/** biquad sections per band: LP pair + allpasses of the higher splits */
+#define CROSSOVER_SECTIONS_MAX  (2 + CROSSOVER_WAYS_MAX - 2)
+
+/** half-band filter: nonzero taps per side, length, delay line */
+#define CROSSOVER_HB_TAPS     4
+#define CROSSOVER_HB_LEN      (4 * CROSSOVER_HB_TAPS - 1)
+
+/** delay line length (power of two, holds delay + decimation latency) */
+#define CROSSOVER_RING        1024
+
+/***************************************************
+            DATA TYPES
+***************************************************/
+
+/** biquad, transposed direct form II */
+typedef struct {
+  float b0, b1, b2, a1, a2;
+  float z1, z2;
+} crossover_biquad_t;
+
+/** half-band decimator / interpolator stage */
+typedef struct {
+  float         hist[2 * CROSSOVER_HB_LEN];  /* delay line, mirrored */
+  unsigned int  pos;                         /* newest sample */
+} crossover_hb_t;
+
+/** one band */
+typedef struct {
+  crossover_biquad_t  sect[CROSSOVER_SECTIONS_MAX];  /* own LP and allpasses */
+  unsigned int        numSect;
+  unsigned int        numDecim;    /* leading sections run at the reduced rate */
+  unsigned int        outMask;     /* CROSSOVER_OUT_xxx */
+  unsigned int        delay;       /* samples at the band rate */
+  float               ring[CROSSOVER_RING];
+  unsigned int        ringPos;
+  float               buf[CROSSOVER_FRAMES_MAX];
+} crossover_band_t;
+
+/** crossover object */
+typedef struct {
+  unsigned int        ways;
+  unsigned int        sampleRate;
+  unsigned int        stages;      /* low band half-band stages, 0 = full rate */
+  unsigned int        latency;     /* decimation latency (full rate samples) */
+  crossover_biquad_t  hp[CROSSOVER_WAYS_MAX - 1][2];  /* high pass of each split */
+  crossover_band_t    band[CROSSOVER_WAYS_MAX];
+  crossover_hb_t      decim[CROSSOVER_DECIM_STAGES_MAX];
+  crossover_hb_t      interp[CROSSOVER_DECIM_STAGES_MAX];
+  float               high[CROSSOVER_FRAMES_MAX];     /* input above the current split */
+  float               scratch[CROSSOVER_FRAMES_MAX];
+} crossover_t;
+
+
+/***************************************************
+            Access Methods
+***************************************************/
+
+/** Initialize the crossover
+ *    - default routing: lowest band left, all others right, no delay
+ *
+ * Parameters:
+ * @param pThis       pointer to own object
+ * @param ways        number of bands
+ * @param pFreqs      ways - 1 crossover frequencies in Hz, ascending
+ * @param sampleRate  frame rate in Hz
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure.
+ */
+int crossover_init(crossover_t *pThis, unsigned int ways, const unsigned int *pFreqs,
+		unsigned int sampleRate);
+
+/** Set routing and delay of a band
+ *
+ * Parameters:
+ * @param pThis    pointer to own object
+ * @param band     band index, 0 = lowest
+ * @param outMask  CROSSOVER_OUT_L and/or CROSSOVER_OUT_R, 0 = muted
+ * @param delayUs  delay (rounded to the band rate, at most CROSSOVER_DELAY_MAX samples)
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure.
+ */
+int crossover_setBand(crossover_t *pThis, unsigned int band, unsigned int outMask,
+		unsigned int delayUs);
+
+/** Split an interleaved stereo S16 chunk in place
+ *    - input L+R is split into the bands, the bands are summed per channel
+ *    - whole L,R frames only (even slot count), frames per chunk:
+ *      multiple of the decimation factor
+ *
+ * Parameters:
+ * @param pThis   pointer to own object
+ * @param pChunk  L,R interleaved chunk (S16, channels = 2)
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure (chunk left unchanged).
+ */
+int crossover_process(crossover_t *pThis, chunk_d_t *pChunk);
+
+#endif
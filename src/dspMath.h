@@ -0,0 +1,120 @@
+/**
+ *@file dspMath.h
+ *
+ *@brief
+ *  - math for coefficient design at init time (double precision)
+ *  - square root for block rate estimates (float)
+ *  - local versions so the application does not need libm (the SDK link
+ *    line has no -lm)
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#ifndef _DSP_MATH_H_
+#define _DSP_MATH_H_
+
+#include <stdint.h>
+
+#define DSPMATH_PI   3.14159265358979323846
+#define DSPMATH_LN2  0.69314718055994530942
+#define DSPMATH_LN10 2.30258509299404568402
+
+/** sin and cos of x, Taylor series after folding x into [-pi, pi]
+ *
+ * Parameters:
+ * @param x     angle in radians
+ * @param pSin  sin(x)
+ * @param pCos  cos(x)
+ */
+static inline void dspMath_sinCos(double x, double *pSin, double *pCos)
+{
+	double s, c = 1.0, term;
+	unsigned int i;
+
+	while (x > DSPMATH_PI) {
+		x -= 2.0 * DSPMATH_PI;
+	}
+	while (x < -DSPMATH_PI) {
+		x += 2.0 * DSPMATH_PI;
+	}
+	s = term = x;
+	for (i = 1; i <= 13; i++) {
+		term *= -x * x / (double) ((2 * i) * (2 * i + 1));
+		s    += term;
+	}
+	term = 1.0;
+	for (i = 1; i <= 13; i++) {
+		term *= -x * x / (double) ((2 * i - 1) * (2 * i));
+		c    += term;
+	}
+	*pSin = s;
+	*pCos = c;
+}
+
+/** e^x, series of the remainder after taking out powers of two
+ *
+ * Parameters:
+ * @param x  exponent
+ *
+ * @return e^x
+ */
+static inline double dspMath_exp(double x)
+{
+	int k = (int) (x / DSPMATH_LN2 + ((x >= 0.0) ? 0.5 : -0.5));
+	double r = x - k * DSPMATH_LN2;  /* |r| <= ln2 / 2 */
+	double sum = 1.0, term = 1.0;
+	unsigned int i;
+
+	for (i = 1; i <= 14; i++) {
+		term *= r / (double) i;
+		sum  += term;
+	}
+	for (; k > 0; k--) {
+		sum *= 2.0;
+	}
+	for (; k < 0; k++) {
+		sum *= 0.5;
+	}
+	return sum;
+}
+
+/** amplitude ratio of a level in dB
+ *
+ * Parameters:
+ * @param db  level in dB
+ *
+ * @return 10^(db / 20)
+ */
+static inline double dspMath_dbToLin(double db)
+{
+	return dspMath_exp(db * DSPMATH_LN10 / 20.0);
+}
+
+/** square root: exponent halving guess, three Newton steps
+ *
+ * Parameters:
+ * @param x  radicand, 0 for x <= 0
+ *
+ * @return sqrt(x)
+ */
+static inline float dspMath_sqrtf(float x)
+{
+	union { float f; uint32_t u; } v;
+	unsigned int i;
+
+	if (x <= 0.0f) {
+		return 0.0f;
+	}
+	v.f = x;
+	v.u = (v.u >> 1) + 0x1FC00000;
+	for (i = 0; i < 3; i++) {
+		v.f = 0.5f * (v.f + x / v.f);
+	}
+	return v.f;
+}
+
+#endif
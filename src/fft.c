@@ -0,0 +1,576 @@
+/**
+ *@file fft.c
+ *
+ *@brief
+ *  - real input FFT/IFFT, float and Q15
+ *
+ * N real samples are treated as N/2 complex values z[n] = x[2n] + i x[2n+1]
+ * (no copy, the interleaved layout is the same). The complex core runs
+ * a radix-2 stage when log2(N/2) is odd, then radix-4 stages on the bit
+ * reversed data. A split pass turns Z into the spectrum of x, the
+ * inverse runs the split backwards and uses the forward core on swapped
+ * re/im (IDFT(Z) * M = swap(DFT(swap(Z)))).
+ *
+ * Radix-4 twiddles depend on the stage length only, not on N, so one
+ * table serves all sizes: the entries of the stage with quarter length h
+ * start at index h - 1 and hold W^j, W^2j, W^3j (W = e^(-2 pi i / 4h))
+ * as separate re/im arrays, four (float) or eight (Q15) butterflies per
+ * NEON iteration. The split twiddles and the bit reversal table are
+ * built for FFT_SIZE_MAX and strided / shifted for smaller sizes. The
+ * split pass walks k up and N/2 - k down and stays scalar, it is O(N).
+ * Tables are computed with dspMath.h, so the host benchmark builds
+ * without the FreeRTOS headers.
+ *
+ * Q15: forward stages halve at every add (vhadd), the inverse saturates
+ * (vqadd). Products round like vqrdmulh, so scalar and NEON agree.
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include "fft.h"
+#include "dspMath.h"
+
+#ifdef __ARM_NEON__
+#include <arm_neon.h>
+#endif
+
+/* complex core size of the largest transform */
+#define FFT_HALF_MAX  (FFT_SIZE_MAX / 2)
+
+/* radix-4 stage entries: h = 1 .. FFT_HALF_MAX / 4 -> indices below FFT_HALF_MAX / 2 */
+#define FFT_TW_NUM    (FFT_HALF_MAX / 2)
+
+/* split twiddles W_N^k, k = 0 .. N/4 */
+#define FFT_SPLIT_NUM (FFT_SIZE_MAX / 4 + 1)
+
+/* shared tables */
+static float          fft_twRe[3][FFT_TW_NUM];
+static float          fft_twIm[3][FFT_TW_NUM];
+static short          fft_twReQ15[3][FFT_TW_NUM];
+static short          fft_twImQ15[3][FFT_TW_NUM];
+static float          fft_splitRe[FFT_SPLIT_NUM];
+static float          fft_splitIm[FFT_SPLIT_NUM];
+static short          fft_splitReQ15[FFT_SPLIT_NUM];
+static short          fft_splitImQ15[FFT_SPLIT_NUM];
+static unsigned short fft_bitrev[FFT_HALF_MAX];
+static int            fft_tablesReady;
+
+
+/* ---- table generation ---- */
+
+static short fft_toQ15(double v)
+{
+	v = v * 32768.0 + ((v < 0.0) ? -0.5 : 0.5);
+	return (v >= 32767.0) ? 32767 : (v <= -32768.0) ? -32768 : (short) v;
+}
+
+static unsigned int fft_log2(unsigned int n)
+{
+	unsigned int l = 0;
+
+	while ((1u << l) < n) {
+		l++;
+	}
+	return l;
+}
+
+/* forward twiddle W = e^(-2 pi i k / n) */
+static void fft_twiddle(unsigned int k, unsigned int n, double *pRe, double *pIm)
+{
+	double s, c;
+
+	dspMath_sinCos(2.0 * DSPMATH_PI * (double) k / (double) n, &s, &c);
+	*pRe = c;
+	*pIm = -s;
+}
+
+static void fft_initTables(void)
+{
+	unsigned int bits = fft_log2(FFT_HALF_MAX);
+	unsigned int h, j, q, i;
+	double re, im;
+
+	/* radix-4 stages */
+	for (h = 1; 4 * h <= FFT_HALF_MAX; h *= 2) {
+		for (j = 0; j < h; j++) {
+			for (q = 0; q < 3; q++) {
+				fft_twiddle((q + 1) * j, 4 * h, &re, &im);
+				fft_twRe[q][h - 1 + j]    = (float) re;
+				fft_twIm[q][h - 1 + j]    = (float) im;
+				fft_twReQ15[q][h - 1 + j] = fft_toQ15(re);
+				fft_twImQ15[q][h - 1 + j] = fft_toQ15(im);
+			}
+		}
+	}
+
+	/* split */
+	for (i = 0; i < FFT_SPLIT_NUM; i++) {
+		fft_twiddle(i, FFT_SIZE_MAX, &re, &im);
+		fft_splitRe[i]    = (float) re;
+		fft_splitIm[i]    = (float) im;
+		fft_splitReQ15[i] = fft_toQ15(re);
+		fft_splitImQ15[i] = fft_toQ15(im);
+	}
+
+	/* bit reversal of the largest core */
+	for (i = 0; i < FFT_HALF_MAX; i++) {
+		unsigned int r = 0, b;
+
+		for (b = 0; b < bits; b++) {
+			r |= ((i >> b) & 1) << (bits - 1 - b);
+		}
+		fft_bitrev[i] = (unsigned short) r;
+	}
+
+	fft_tablesReady = 1;
+}
+
+/* Initialize a transform */
+int fft_init(fft_t *pThis, unsigned int size)
+{
+	if (size < FFT_SIZE_MIN || size > FFT_SIZE_MAX || (size & (size - 1))) {
+		printf("[FFT]: size %u not supported\r\n", size);
+		return -1;
+	}
+
+	if (!fft_tablesReady) {
+		fft_initTables();
+	}
+
+	pThis->size        = size;
+	pThis->log2Half    = fft_log2(size / 2);
+	pThis->bitrevShift = fft_log2(FFT_HALF_MAX) - pThis->log2Half;
+	pThis->splitStride = FFT_SIZE_MAX / size;
+	return 0;
+}
+
+
+/* ---- float core ---- */
+
+static void fft_bitReverse(const fft_t *pThis, float *pX)
+{
+	unsigned int m = 1u << pThis->log2Half, i;
+
+	for (i = 0; i < m; i++) {
+		unsigned int r = fft_bitrev[i] >> pThis->bitrevShift;
+
+		if (i < r) {
+			float tr = pX[2 * i], ti = pX[2 * i + 1];
+
+			pX[2 * i]     = pX[2 * r];
+			pX[2 * i + 1] = pX[2 * r + 1];
+			pX[2 * r]     = tr;
+			pX[2 * r + 1] = ti;
+		}
+	}
+}
+
+static void fft_radix4(float *pX, unsigned int m, unsigned int h)
+{
+	const float *w1r = &fft_twRe[0][h - 1], *w1i = &fft_twIm[0][h - 1];
+	const float *w2r = &fft_twRe[1][h - 1], *w2i = &fft_twIm[1][h - 1];
+	const float *w3r = &fft_twRe[2][h - 1], *w3i = &fft_twIm[2][h - 1];
+	unsigned int s, j;
+
+	for (s = 0; s < m; s += 4 * h) {
+		float *pA = &pX[2 * s];
+		float *pB = pA + 2 * h;
+		float *pC = pA + 4 * h;
+		float *pD = pA + 6 * h;
+
+		j = 0;
+#ifdef __ARM_NEON__
+		for (; j + 4 <= h; j += 4) {
+			float32x4x2_t a = vld2q_f32(&pA[2 * j]);
+			float32x4x2_t b = vld2q_f32(&pB[2 * j]);
+			float32x4x2_t c = vld2q_f32(&pC[2 * j]);
+			float32x4x2_t d = vld2q_f32(&pD[2 * j]);
+			float32x4_t wr, wi, b1r, b1i, c1r, c1i, d1r, d1i;
+			float32x4_t t0r, t0i, t1r, t1i, t2r, t2i, t3r, t3i;
+
+			wr  = vld1q_f32(&w2r[j]);
+			wi  = vld1q_f32(&w2i[j]);
+			b1r = vmlsq_f32(vmulq_f32(b.val[0], wr), b.val[1], wi);
+			b1i = vmlaq_f32(vmulq_f32(b.val[0], wi), b.val[1], wr);
+			wr  = vld1q_f32(&w1r[j]);
+			wi  = vld1q_f32(&w1i[j]);
+			c1r = vmlsq_f32(vmulq_f32(c.val[0], wr), c.val[1], wi);
+			c1i = vmlaq_f32(vmulq_f32(c.val[0], wi), c.val[1], wr);
+			wr  = vld1q_f32(&w3r[j]);
+			wi  = vld1q_f32(&w3i[j]);
+			d1r = vmlsq_f32(vmulq_f32(d.val[0], wr), d.val[1], wi);
+			d1i = vmlaq_f32(vmulq_f32(d.val[0], wi), d.val[1], wr);
+
+			t0r = vaddq_f32(a.val[0], b1r);  t0i = vaddq_f32(a.val[1], b1i);
+			t1r = vsubq_f32(a.val[0], b1r);  t1i = vsubq_f32(a.val[1], b1i);
+			t2r = vaddq_f32(c1r, d1r);       t2i = vaddq_f32(c1i, d1i);
+			t3r = vsubq_f32(c1r, d1r);       t3i = vsubq_f32(c1i, d1i);
+
+			a.val[0] = vaddq_f32(t0r, t2r);  a.val[1] = vaddq_f32(t0i, t2i);
+			c.val[0] = vsubq_f32(t0r, t2r);  c.val[1] = vsubq_f32(t0i, t2i);
+			b.val[0] = vaddq_f32(t1r, t3i);  b.val[1] = vsubq_f32(t1i, t3r);
+			d.val[0] = vsubq_f32(t1r, t3i);  d.val[1] = vaddq_f32(t1i, t3r);
+
+			vst2q_f32(&pA[2 * j], a);
+			vst2q_f32(&pB[2 * j], b);
+			vst2q_f32(&pC[2 * j], c);
+			vst2q_f32(&pD[2 * j], d);
+		}
+#endif
+		for (; j < h; j++) {
+			float ar = pA[2 * j], ai = pA[2 * j + 1];
+			float br = pB[2 * j], bi = pB[2 * j + 1];
+			float cr = pC[2 * j], ci = pC[2 * j + 1];
+			float dr = pD[2 * j], di = pD[2 * j + 1];
+			float b1r = br * w2r[j] - bi * w2i[j], b1i = br * w2i[j] + bi * w2r[j];
+			float c1r = cr * w1r[j] - ci * w1i[j], c1i = cr * w1i[j] + ci * w1r[j];
+			float d1r = dr * w3r[j] - di * w3i[j], d1i = dr * w3i[j] + di * w3r[j];
+			float t0r = ar + b1r, t0i = ai + b1i;
+			float t1r = ar - b1r, t1i = ai - b1i;
+			float t2r = c1r + d1r, t2i = c1i + d1i;
+			float t3r = c1r - d1r, t3i = c1i - d1i;
+
+			pA[2 * j] = t0r + t2r;  pA[2 * j + 1] = t0i + t2i;
+			pC[2 * j] = t0r - t2r;  pC[2 * j + 1] = t0i - t2i;
+			pB[2 * j] = t1r + t3i;  pB[2 * j + 1] = t1i - t3r;
+			pD[2 * j] = t1r - t3i;  pD[2 * j + 1] = t1i + t3r;
+		}
+	}
+}
+
+/* complex DFT of N/2 values in place */
+static void fft_complex(const fft_t *pThis, float *pX)
+{
+	unsigned int m = 1u << pThis->log2Half, h = 1, i;
+
+	fft_bitReverse(pThis, pX);
+
+	if (pThis->log2Half & 1) {
+		for (i = 0; i < m; i += 2) {
+			float ar = pX[2 * i],     ai = pX[2 * i + 1];
+			float br = pX[2 * i + 2], bi = pX[2 * i + 3];
+
+			pX[2 * i]     = ar + br;  pX[2 * i + 1] = ai + bi;
+			pX[2 * i + 2] = ar - br;  pX[2 * i + 3] = ai - bi;
+		}
+		h = 2;
+	}
+	for (; h < m; h *= 4) {
+		fft_radix4(pX, m, h);
+	}
+}
+
+/* Forward transform in place, float */
+void fft_forward(const fft_t *pThis, float *pData)
+{
+	unsigned int m = pThis->size / 2, k;
+	float z0r, z0i;
+
+	fft_complex(pThis, pData);
+
+	/* X[k] = E + W^k O, X[m - k] = conj(E - W^k O) */
+	z0r = pData[0];
+	z0i = pData[1];
+	pData[0] = z0r + z0i;
+	pData[1] = z0r - z0i;
+	for (k = 1; k <= m / 2; k++) {
+		unsigned int j = m - k;
+		float wr = fft_splitRe[k * pThis->splitStride];
+		float wi = fft_splitIm[k * pThis->splitStride];
+		float zkr = pData[2 * k], zki = pData[2 * k + 1];
+		float zjr = pData[2 * j], zji = pData[2 * j + 1];
+		float er = 0.5f * (zkr + zjr), ei = 0.5f * (zki - zji);
+		float odr = 0.5f * (zki + zji), odi = 0.5f * (zjr - zkr);
+		float tr = wr * odr - wi * odi,  ti = wr * odi + wi * odr;
+
+		pData[2 * k] = er + tr;  pData[2 * k + 1] = ei + ti;
+		pData[2 * j] = er - tr;  pData[2 * j + 1] = ti - ei;
+	}
+}
+
+/* Inverse transform in place, float */
+void fft_inverse(const fft_t *pThis, float *pData)
+{
+	unsigned int m = pThis->size / 2, k, i;
+	float x0 = pData[0], xm = pData[1];
+	float scale = 1.0f / (float) m;
+
+	/* Z[k] = E + i O, stored with re/im swapped */
+	pData[0] = 0.5f * (x0 - xm);
+	pData[1] = 0.5f * (x0 + xm);
+	for (k = 1; k <= m / 2; k++) {
+		unsigned int j = m - k;
+		float wr = fft_splitRe[k * pThis->splitStride];
+		float wi = fft_splitIm[k * pThis->splitStride];
+		float xkr = pData[2 * k], xki = pData[2 * k + 1];
+		float xjr = pData[2 * j], xji = pData[2 * j + 1];
+		float er = 0.5f * (xkr + xjr), ei = 0.5f * (xki - xji);
+		float tr = 0.5f * (xkr - xjr), ti = 0.5f * (xki + xji);
+		float odr = wr * tr + wi * ti,  odi = wr * ti - wi * tr;
+
+		pData[2 * k] = ei + odr;  pData[2 * k + 1] = er - odi;
+		pData[2 * j] = odr - ei;  pData[2 * j + 1] = er + odi;
+	}
+
+	fft_complex(pThis, pData);
+
+	/* swap back, 1/m */
+	i = 0;
+#ifdef __ARM_NEON__
+	for (; i + 4 <= pThis->size; i += 4) {
+		vst1q_f32(&pData[i], vmulq_n_f32(vrev64q_f32(vld1q_f32(&pData[i])), scale));
+	}
+#endif
+	for (; i < pThis->size; i += 2) {
+		float re = pData[i + 1];
+
+		pData[i + 1] = pData[i] * scale;
+		pData[i]     = re * scale;
+	}
+}
+
+
+/* ---- Q15 core ---- */
+
+static inline short fft_sat(int v)
+{
+	return (v > 32767) ? 32767 : (v < -32768) ? -32768 : (short) v;
+}
+
+/* rounding Q15 product, same as vqrdmulh */
+static inline int fft_mulQ15(int a, int b)
+{
+	return (a * b + (1 << 14)) >> 15;
+}
+
+static void fft_bitReverseQ15(const fft_t *pThis, short *pX)
+{
+	unsigned int m = 1u << pThis->log2Half, i;
+
+	for (i = 0; i < m; i++) {
+		unsigned int r = fft_bitrev[i] >> pThis->bitrevShift;
+
+		if (i < r) {
+			short tr = pX[2 * i], ti = pX[2 * i + 1];
+
+			pX[2 * i]     = pX[2 * r];
+			pX[2 * i + 1] = pX[2 * r + 1];
+			pX[2 * r]     = tr;
+			pX[2 * r + 1] = ti;
+		}
+	}
+}
+
+#ifdef __ARM_NEON__
+/* Q15 complex product, eight lanes */
+#define FFT_CMUL_Q15(OR, OI, XR, XI, WR, WI) \
+	OR = vqsubq_s16(vqrdmulhq_s16(XR, WR), vqrdmulhq_s16(XI, WI)); \
+	OI = vqaddq_s16(vqrdmulhq_s16(XR, WI), vqrdmulhq_s16(XI, WR));
+
+/* eight radix-4 butterflies per iteration, ADD/SUB halve or saturate */
+#define FFT_RADIX4_Q15_LOOP(ADD, SUB) \
+	for (; j + 8 <= h; j += 8) { \
+		int16x8x2_t a = vld2q_s16(&pA[2 * j]); \
+		int16x8x2_t b = vld2q_s16(&pB[2 * j]); \
+		int16x8x2_t c = vld2q_s16(&pC[2 * j]); \
+		int16x8x2_t d = vld2q_s16(&pD[2 * j]); \
+		int16x8_t b1r, b1i, c1r, c1i, d1r, d1i, t0r, t0i, t1r, t1i, t2r, t2i, t3r, t3i; \
+		FFT_CMUL_Q15(b1r, b1i, b.val[0], b.val[1], vld1q_s16(&w2r[j]), vld1q_s16(&w2i[j])) \
+		FFT_CMUL_Q15(c1r, c1i, c.val[0], c.val[1], vld1q_s16(&w1r[j]), vld1q_s16(&w1i[j])) \
+		FFT_CMUL_Q15(d1r, d1i, d.val[0], d.val[1], vld1q_s16(&w3r[j]), vld1q_s16(&w3i[j])) \
+		t0r = ADD(a.val[0], b1r);  t0i = ADD(a.val[1], b1i); \
+		t1r = SUB(a.val[0], b1r);  t1i = SUB(a.val[1], b1i); \
+		t2r = ADD(c1r, d1r);       t2i = ADD(c1i, d1i); \
+		t3r = SUB(c1r, d1r);       t3i = SUB(c1i, d1i); \
+		a.val[0] = ADD(t0r, t2r);  a.val[1] = ADD(t0i, t2i); \
+		c.val[0] = SUB(t0r, t2r);  c.val[1] = SUB(t0i, t2i); \
+		b.val[0] = ADD(t1r, t3i);  b.val[1] = SUB(t1i, t3r); \
+		d.val[0] = SUB(t1r, t3i);  d.val[1] = ADD(t1i, t3r); \
+		vst2q_s16(&pA[2 * j], a); \
+		vst2q_s16(&pB[2 * j], b); \
+		vst2q_s16(&pC[2 * j], c); \
+		vst2q_s16(&pD[2 * j], d); \
+	}
+#endif
+
+/* shift 1: halve at every add (forward), 0: saturate (inverse) */
+static void fft_radix4Q15(short *pX, unsigned int m, unsigned int h, unsigned int shift)
+{
+	const short *w1r = &fft_twReQ15[0][h - 1], *w1i = &fft_twImQ15[0][h - 1];
+	const short *w2r = &fft_twReQ15[1][h - 1], *w2i = &fft_twImQ15[1][h - 1];
+	const short *w3r = &fft_twReQ15[2][h - 1], *w3i = &fft_twImQ15[2][h - 1];
+	unsigned int s, j;
+
+	for (s = 0; s < m; s += 4 * h) {
+		short *pA = &pX[2 * s];
+		short *pB = pA + 2 * h;
+		short *pC = pA + 4 * h;
+		short *pD = pA + 6 * h;
+
+		j = 0;
+#ifdef __ARM_NEON__
+		if (shift) {
+			FFT_RADIX4_Q15_LOOP(vhaddq_s16, vhsubq_s16)
+		} else {
+			FFT_RADIX4_Q15_LOOP(vqaddq_s16, vqsubq_s16)
+		}
+#endif
+		for (; j < h; j++) {
+			int ar = pA[2 * j], ai = pA[2 * j + 1];
+			int br = pB[2 * j], bi = pB[2 * j + 1];
+			int cr = pC[2 * j], ci = pC[2 * j + 1];
+			int dr = pD[2 * j], di = pD[2 * j + 1];
+			int b1r = fft_sat(fft_mulQ15(br, w2r[j]) - fft_mulQ15(bi, w2i[j]));
+			int b1i = fft_sat(fft_mulQ15(br, w2i[j]) + fft_mulQ15(bi, w2r[j]));
+			int c1r = fft_sat(fft_mulQ15(cr, w1r[j]) - fft_mulQ15(ci, w1i[j]));
+			int c1i = fft_sat(fft_mulQ15(cr, w1i[j]) + fft_mulQ15(ci, w1r[j]));
+			int d1r = fft_sat(fft_mulQ15(dr, w3r[j]) - fft_mulQ15(di, w3i[j]));
+			int d1i = fft_sat(fft_mulQ15(dr, w3i[j]) + fft_mulQ15(di, w3r[j]));
+			int t0r = fft_sat((ar + b1r) >> shift), t0i = fft_sat((ai + b1i) >> shift);
+			int t1r = fft_sat((ar - b1r) >> shift), t1i = fft_sat((ai - b1i) >> shift);
+			int t2r = fft_sat((c1r + d1r) >> shift), t2i = fft_sat((c1i + d1i) >> shift);
+			int t3r = fft_sat((c1r - d1r) >> shift), t3i = fft_sat((c1i - d1i) >> shift);
+
+			pA[2 * j] = fft_sat((t0r + t2r) >> shift);  pA[2 * j + 1] = fft_sat((t0i + t2i) >> shift);
+			pC[2 * j] = fft_sat((t0r - t2r) >> shift);  pC[2 * j + 1] = fft_sat((t0i - t2i) >> shift);
+			pB[2 * j] = fft_sat((t1r + t3i) >> shift);  pB[2 * j + 1] = fft_sat((t1i - t3r) >> shift);
+			pD[2 * j] = fft_sat((t1r - t3i) >> shift);  pD[2 * j + 1] = fft_sat((t1i + t3r) >> shift);
+		}
+	}
+}
+
+/* complex DFT of N/2 values in place, scaled by 1/(N/2) if shift is 1 */
+static void fft_complexQ15(const fft_t *pThis, short *pX, unsigned int shift)
+{
+	unsigned int m = 1u << pThis->log2Half, h = 1, i;
+
+	fft_bitReverseQ15(pThis, pX);
+
+	if (pThis->log2Half & 1) {
+		for (i = 0; i < m; i += 2) {
+			int ar = pX[2 * i],     ai = pX[2 * i + 1];
+			int br = pX[2 * i + 2], bi = pX[2 * i + 3];
+
+			pX[2 * i]     = fft_sat((ar + br) >> shift);  pX[2 * i + 1] = fft_sat((ai + bi) >> shift);
+			pX[2 * i + 2] = fft_sat((ar - br) >> shift);  pX[2 * i + 3] = fft_sat((ai - bi) >> shift);
+		}
+		h = 2;
+	}
+	for (; h < m; h *= 4) {
+		fft_radix4Q15(pX, m, h, shift);
+	}
+}
+
+/* Forward transform in place, Q15: the core returns Z/m, the split halves once more -> X/N */
+void fft_forwardQ15(const fft_t *pThis, short *pData)
+{
+	unsigned int m = pThis->size / 2, k;
+	int z0r, z0i;
+
+	fft_complexQ15(pThis, pData, 1);
+
+	z0r = pData[0];
+	z0i = pData[1];
+	pData[0] = fft_sat((z0r + z0i) >> 1);
+	pData[1] = fft_sat((z0r - z0i) >> 1);
+	for (k = 1; k <= m / 2; k++) {
+		unsigned int j = m - k;
+		int wr = fft_splitReQ15[k * pThis->splitStride];
+		int wi = fft_splitImQ15[k * pThis->splitStride];
+		int zkr = pData[2 * k], zki = pData[2 * k + 1];
+		int zjr = pData[2 * j], zji = pData[2 * j + 1];
+		int er = (zkr + zjr) >> 1, ei = (zki - zji) >> 1;
+		int odr = (zki + zji) >> 1, odi = (zjr - zkr) >> 1;
+		int tr = fft_mulQ15(wr, odr) - fft_mulQ15(wi, odi);
+		int ti = fft_mulQ15(wr, odi) + fft_mulQ15(wi, odr);
+
+		pData[2 * k] = fft_sat((er + tr) >> 1);  pData[2 * k + 1] = fft_sat((ei + ti) >> 1);
+		pData[2 * j] = fft_sat((er - tr) >> 1);  pData[2 * j + 1] = fft_sat((ti - ei) >> 1);
+	}
+}
+
+/* Inverse transform in place, Q15: 2 Z / N into the unscaled core gives the samples */
+void fft_inverseQ15(const fft_t *pThis, short *pData)
+{
+	unsigned int m = pThis->size / 2, k, i;
+	int x0 = pData[0], xm = pData[1];
+
+	pData[0] = fft_sat(x0 - xm);
+	pData[1] = fft_sat(x0 + xm);
+	for (k = 1; k <= m / 2; k++) {
+		unsigned int j = m - k;
+		int wr = fft_splitReQ15[k * pThis->splitStride];
+		int wi = fft_splitImQ15[k * pThis->splitStride];
+		int xkr = pData[2 * k], xki = pData[2 * k + 1];
+		int xjr = pData[2 * j], xji = pData[2 * j + 1];
+		int er = xkr + xjr, ei = xki - xji;
+		int tr = xkr - xjr, ti = xki + xji;
+		int odr = fft_mulQ15(wr, tr) + fft_mulQ15(wi, ti);
+		int odi = fft_mulQ15(wr, ti) - fft_mulQ15(wi, tr);
+
+		pData[2 * k] = fft_sat(ei + odr);  pData[2 * k + 1] = fft_sat(er - odi);
+		pData[2 * j] = fft_sat(odr - ei);  pData[2 * j + 1] = fft_sat(er + odi);
+	}
+
+	fft_complexQ15(pThis, pData, 0);
+
+	/* swap back */
+	i = 0;
+#ifdef __ARM_NEON__
+	for (; i + 8 <= pThis->size; i += 8) {
+		vst1q_s16(&pData[i], vrev32q_s16(vld1q_s16(&pData[i])));
+	}
+#endif
+	for (; i < pThis->size; i += 2) {
+		short re = pData[i + 1];
+
+		pData[i + 1] = pData[i];
+		pData[i]     = re;
+	}
+}
+
+
+/* ---- chunk payloads ---- */
+
+static int fft_chunkCheck(const fft_t *pThis, const chunk_d_t *pChunk)
+{
+	if (pChunk->bytesUsed != (int) (pThis->size * sizeof(unsigned int)) || 1 != pChunk->channels
+			|| (CHUNK_FMT_F32 != pChunk->format && CHUNK_FMT_S16 != pChunk->format)) {
+		return -1;
+	}
+	return 0;
+}
+
+/* Forward transform of a chunk payload in place */
+int fft_chunkForward(const fft_t *pThis, chunk_d_t *pChunk)
+{
+	if (0 != fft_chunkCheck(pThis, pChunk)) {
+		return -1;
+	}
+	if (CHUNK_FMT_F32 == pChunk->format) {
+		fft_forward(pThis, (float *) pChunk->u32_buff);
+	} else {
+		fft_forwardQ15(pThis, pChunk->s16_buff);
+	}
+	return 0;
+}
+
+/* Inverse transform of a chunk payload in place */
+int fft_chunkInverse(const fft_t *pThis, chunk_d_t *pChunk)
+{
+	if (0 != fft_chunkCheck(pThis, pChunk)) {
+		return -1;
+	}
+	if (CHUNK_FMT_F32 == pChunk->format) {
+		fft_inverse(pThis, (float *) pChunk->u32_buff);
+	} else {
+		fft_inverseQ15(pThis, pChunk->s16_buff);
+	}
+	return 0;
+}
@@ -0,0 +1,122 @@
+/**
+ *@file fft.h
+ *
+ *@brief
+ *  - real input FFT/IFFT, power of two sizes FFT_SIZE_MIN..FFT_SIZE_MAX
+ *  - float and Q15 variants, in place on a sample buffer or chunk payload
+ *  - twiddle and bit reversal tables are built once for FFT_SIZE_MAX and
+ *    shared by all sizes
+ *
+ * Spectrum layout (packed, N real samples -> N values):
+ *   [ X[0], X[N/2], Re X[1], Im X[1], ..., Re X[N/2-1], Im X[N/2-1] ]
+ * X[0] and X[N/2] are real. Float: X is the plain DFT, the inverse scales
+ * by 1/N. Q15: the forward transform returns X/N, the inverse takes X/N
+ * and returns the samples (round trip at unity gain).
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#ifndef _FFT_H_
+#define _FFT_H_
+
+#include "chunk_d.h"
+
+/***************************************************
+            DEFINES
+***************************************************/
+
+/** smallest transform (real samples) */
+#define FFT_SIZE_MIN  64
+
+/** largest transform (real samples), sizes the shared tables */
+#ifndef FFT_SIZE_MAX
+#define FFT_SIZE_MAX  8192
+#endif
+
+/***************************************************
+            DATA TYPES
+***************************************************/
+
+/** transform of one size */
+typedef struct {
+  unsigned int  size;         /* real samples (N) */
+  unsigned int  log2Half;     /* log2 of the complex core size N/2 */
+  unsigned int  bitrevShift;  /* shared bit reversal table -> N/2 */
+  unsigned int  splitStride;  /* shared split twiddles -> N */
+} fft_t;
+
+
+/***************************************************
+            Access Methods
+***************************************************/
+
+/** Initialize a transform, the first call builds the shared tables
+ *    - call from init code, not concurrently
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ * @param size   real samples, power of two FFT_SIZE_MIN..FFT_SIZE_MAX
+ *
+ * @return Zero on success, negative value on invalid size
+ */
+int fft_init(fft_t *pThis, unsigned int size);
+
+/** Forward transform in place, float
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ * @param pData  N samples in, packed spectrum out
+ */
+void fft_forward(const fft_t *pThis, float *pData);
+
+/** Inverse transform in place, float
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ * @param pData  packed spectrum in, N samples out
+ */
+void fft_inverse(const fft_t *pThis, float *pData);
+
+/** Forward transform in place, Q15 (scaled by 1/N)
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ * @param pData  N samples in, packed spectrum / N out
+ */
+void fft_forwardQ15(const fft_t *pThis, short *pData);
+
+/** Inverse transform in place, Q15 (saturating)
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ * @param pData  packed spectrum / N in, N samples out
+ */
+void fft_inverseQ15(const fft_t *pThis, short *pData);
+
+/** Forward transform of a mono chunk payload in place
+ *    - CHUNK_FMT_F32 runs the float, CHUNK_FMT_S16 the Q15 transform
+ *    - the chunk has to hold exactly N samples, stereo chunks are rejected
+ *
+ * Parameters:
+ * @param pThis   pointer to own object
+ * @param pChunk  samples in, packed spectrum out (same format)
+ *
+ * @return Zero on success, negative value on size, format or channel mismatch
+ */
+int fft_chunkForward(const fft_t *pThis, chunk_d_t *pChunk);
+
+/** Inverse transform of a chunk payload in place
+ *
+ * Parameters:
+ * @param pThis   pointer to own object
+ * @param pChunk  packed spectrum in, samples out
+ *
+ * @return Zero on success, negative value on size, format or channel mismatch
+ */
+int fft_chunkInverse(const fft_t *pThis, chunk_d_t *pChunk);
+
+#endif
@@ -0,0 +1,130 @@
+/**
+ *@file fileIo.c
+ *
+ *@brief
+ *  - minimal file access: FatFs on the board (FILEIO_FATFS), stdio with
+ *    FILEIO_POSIX, no file system otherwise
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#include "fileIo.h"
+#include "zedboard_freertos.h"
+
+#if !defined(FILEIO_POSIX) && FILEIO_FATFS
+/* FatFs work area for the SD card volume */
+static FATFS fileIo_fatFs;
+#endif
+
+/* volume mounted, opens allowed */
+static int fileIo_mounted;
+
+/* Mount the file system */
+int fileIo_mount(void)
+{
+#ifdef FILEIO_POSIX
+	fileIo_mounted = 1;
+	return PASS;
+#elif FILEIO_FATFS
+	FRESULT res = f_mount(&fileIo_fatFs, FILEIO_VOLUME, 1);
+
+	if (FR_OK != res) {
+		printf("[FILE]: Failed to mount %s (FatFs error %d)\r\n", FILEIO_VOLUME, (int) res);
+		return -1;
+	}
+	fileIo_mounted = 1;
+	return PASS;
+#else
+	printf("[FILE]: no file system (built without FILEIO_FATFS)\r\n");
+	return -1;
+#endif
+}
+
+/* Open a file */
+int fileIo_open(fileIo_t *pThis, const char *path, int mode)
+{
+	if (NULL == pThis || NULL == path) {
+		return -1;
+	}
+	pThis->isOpen = 0;
+	if (!fileIo_mounted) {
+		printf("[FILE]: no file system mounted, can not open %s\r\n", path);
+		return -1;
+	}
+
+#ifdef FILEIO_POSIX
+	pThis->fp = fopen(path, (FILEIO_WRITE == mode) ? "wb" : "rb");
+	pThis->isOpen = (NULL != pThis->fp);
+#elif FILEIO_FATFS
+	pThis->isOpen = (FR_OK == f_open(&pThis->fil, path,
+			(FILEIO_WRITE == mode) ? (FA_WRITE | FA_CREATE_ALWAYS) : FA_READ));
+#endif
+
+	if (!pThis->isOpen) {
+		printf("[FILE]: Failed to open %s\r\n", path);
+		return -1;
+	}
+	return PASS;
+}
+
+/* Read up to len bytes */
+int fileIo_read(fileIo_t *pThis, void *pBuf, unsigned int len)
+{
+#ifdef FILEIO_POSIX
+	return (int) fread(pBuf, 1, len, pThis->fp);
+#elif FILEIO_FATFS
+	UINT bytesRead = 0;
+	if (FR_OK != f_read(&pThis->fil, pBuf, len, &bytesRead)) {
+		return -1;
+	}
+	return (int) bytesRead;
+#else
+	return -1;
+#endif
+}
+
+/* Write len bytes */
+int fileIo_write(fileIo_t *pThis, const void *pBuf, unsigned int len)
+{
+#ifdef FILEIO_POSIX
+	return (int) fwrite(pBuf, 1, len, pThis->fp);
+#elif FILEIO_FATFS
+	UINT bytesWritten = 0;
+	if (FR_OK != f_write(&pThis->fil, pBuf, len, &bytesWritten)) {
+		return -1;
+	}
+	return (int) bytesWritten;
+#else
+	return -1;
+#endif
+}
+
+/* Move to an absolute byte offset */
+int fileIo_seek(fileIo_t *pThis, unsigned int offset)
+{
+#ifdef FILEIO_POSIX
+	return (0 == fseek(pThis->fp, offset, SEEK_SET)) ? PASS : -1;
+#elif FILEIO_FATFS
+	return (FR_OK == f_lseek(&pThis->fil, offset)) ? PASS : -1;
+#else
+	return -1;
+#endif
+}
+
+/* Close the file */
+void fileIo_close(fileIo_t *pThis)
+{
+	if (!pThis->isOpen) {
+		return;
+	}
+#ifdef FILEIO_POSIX
+	fclose(pThis->fp);
+#elif FILEIO_FATFS
+	f_close(&pThis->fil);
+#endif
+	pThis->isOpen = 0;
+}
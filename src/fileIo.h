@@ -0,0 +1,112 @@
+/**
+ *@file fileIo.h
+ *
+ *@brief
+ *  - minimal file access used by streaming sources and exporters
+ *  - FatFs (xilffs) on the SD card for the board when built with
+ *    FILEIO_FATFS (the BSP has to include the xilffs library),
+ *    plain stdio files when built with FILEIO_POSIX (host stand-in),
+ *    otherwise no file system: every open fails
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#ifndef _FILE_IO_H_
+#define _FILE_IO_H_
+
+/**
+ * @def FILEIO_FATFS
+ * @brief 1: SD card through FatFs (BSP with xilffs), 0: no file system
+ */
+#ifndef FILEIO_FATFS
+#define FILEIO_FATFS 0
+#endif
+
+#ifdef FILEIO_POSIX
+#include <stdio.h>
+#elif FILEIO_FATFS
+#include "ff.h"
+#endif
+
+/***************************************************
+            DEFINES
+***************************************************/
+
+/** open modes */
+#define FILEIO_READ  0
+#define FILEIO_WRITE 1 /* create/truncate */
+
+/**
+ * @def FILEIO_VOLUME
+ * @brief logical drive the SD card is mounted as
+ */
+#define FILEIO_VOLUME "0:/"
+
+/***************************************************
+            DATA TYPES
+***************************************************/
+
+/** file object
+ */
+typedef struct {
+#ifdef FILEIO_POSIX
+  FILE *fp;
+#elif FILEIO_FATFS
+  FIL   fil;
+#endif
+  int   isOpen;
+} fileIo_t;
+
+
+/***************************************************
+            Access Methods
+***************************************************/
+
+/** Mount the file system (once at startup, no-op on the host)
+ *   - opens fail until a mount succeeded
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure.
+ */
+int fileIo_mount(void);
+
+/** Open a file
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ * @param path   file name
+ * @param mode   FILEIO_READ or FILEIO_WRITE
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure.
+ */
+int fileIo_open(fileIo_t *pThis, const char *path, int mode);
+
+/** Read up to len bytes
+ *
+ * @return number of bytes read, negative value on failure
+ */
+int fileIo_read(fileIo_t *pThis, void *pBuf, unsigned int len);
+
+/** Write len bytes
+ *
+ * @return number of bytes written, negative value on failure
+ */
+int fileIo_write(fileIo_t *pThis, const void *pBuf, unsigned int len);
+
+/** Move read/write position to an absolute byte offset
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure.
+ */
+int fileIo_seek(fileIo_t *pThis, unsigned int offset);
+
+/** Close the file (safe to call on a closed file)
+ */
+void fileIo_close(fileIo_t *pThis);
+
+#endif
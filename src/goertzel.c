@@ -0,0 +1,244 @@
+/**
+ *@file goertzel.c
+ *
+ *@brief
+ *  - Goertzel filter bank
+ *
+ * Per bin and frame: s0 = x + c * s1 - s2, c = 2 cos(2 pi k / N).
+ * After N frames the bin power is s1^2 + s2^2 - c * s1 * s2, the same
+ * as |X[k]|^2 of an N point DFT. Bins are padded to groups of four,
+ * each group is one float32x4 state with NEON. The coefficients are
+ * computed once at init, sqrt for the amplitude comes from dspMath.h as
+ * well so the application does not need libm. Stereo chunks are fed
+ * frame by frame as (L+R)/2, so N and the bins are in frames.
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#include <string.h>
+#include "goertzel.h"
+#include "dspMath.h"
+#include "zedboard_freertos.h"
+
+#ifdef __ARM_NEON__
+#include <arm_neon.h>
+#endif
+
+/* DTMF tones: rows then columns */
+static const unsigned int goertzel_dtmfFreqs[GOERTZEL_DTMF_BINS] = {
+	697, 770, 852, 941, 1209, 1336, 1477, 1633
+};
+
+static const char goertzel_dtmfKeys[4][4] = {
+	{ '1', '2', '3', 'A' },
+	{ '4', '5', '6', 'B' },
+	{ '7', '8', '9', 'C' },
+	{ '*', '0', '#', 'D' },
+};
+
+/* DTMF acceptance: both tones hold this share of the block energy */
+#define GOERTZEL_DTMF_MIN_RATIO   0.4f
+/* each tone at least this share */
+#define GOERTZEL_DTMF_MIN_TONE    0.1f
+/* strongest tone of a group this much above the others (6 dB) */
+#define GOERTZEL_DTMF_GROUP_RATIO 4.0f
+/* row/column power ratio (twist) up to 8 dB */
+#define GOERTZEL_DTMF_TWIST       6.3f
+
+/* Initialize the bank */
+int goertzel_init(goertzel_t *pThis, const unsigned int *pFreqs, unsigned int numBins,
+		unsigned int sampleRate, unsigned int blockFrames)
+{
+	unsigned int i;
+	double s, c;
+
+	if (0 == numBins || numBins > GOERTZEL_BINS_MAX || 0 == sampleRate || blockFrames < 2) {
+		printf("[GZ]: invalid bank (%u bins, %u frames)\r\n", numBins, blockFrames);
+		return FAIL;
+	}
+
+	memset(pThis, 0, sizeof(*pThis));
+	pThis->numBins      = numBins;
+	pThis->blockFrames  = blockFrames;
+
+	/* nearest bin of the block: no leakage for a tone on the bin */
+	for (i = 0; i < numBins; i++) {
+		unsigned int k = (unsigned int) (((uint64_t) pFreqs[i] * blockFrames + sampleRate / 2) / sampleRate);
+
+		if (k >= blockFrames / 2) {
+			printf("[GZ]: %u Hz above Nyquist\r\n", pFreqs[i]);
+			return FAIL;
+		}
+		dspMath_sinCos(2.0 * DSPMATH_PI * k / blockFrames, &s, &c);
+		pThis->coeff[i] = (float) (2.0 * c);
+	}
+	/* padding bins keep c = 0, results are ignored */
+
+	return PASS;
+}
+
+/* one frame: mono sample or (L+R)/2 */
+static inline float goertzel_frame(const short *pSrc, unsigned int i, unsigned int channels)
+{
+	return (2 == channels) ? 0.5f * ((float) pSrc[2 * i] + (float) pSrc[2 * i + 1]) : (float) pSrc[i];
+}
+
+/* Run a range of frames through the filter states */
+static void goertzel_run(goertzel_t *pThis, const short *pSrc, unsigned int n, unsigned int channels)
+{
+	unsigned int g, i;
+	float energy = pThis->energy;
+
+	for (i = 0; i < n; i++) {
+		float x = goertzel_frame(pSrc, i, channels);
+
+		energy += x * x;
+	}
+	pThis->energy = energy;
+
+	for (g = 0; g < pThis->numBins; g += 4) {
+#ifdef __ARM_NEON__
+		float32x4_t c  = vld1q_f32(&pThis->coeff[g]);
+		float32x4_t s1 = vld1q_f32(&pThis->s1[g]);
+		float32x4_t s2 = vld1q_f32(&pThis->s2[g]);
+
+		for (i = 0; i < n; i++) {
+			float32x4_t s0 = vsubq_f32(vmlaq_f32(vdupq_n_f32(goertzel_frame(pSrc, i, channels)), c, s1), s2);
+
+			s2 = s1;
+			s1 = s0;
+		}
+		vst1q_f32(&pThis->s1[g], s1);
+		vst1q_f32(&pThis->s2[g], s2);
+#else
+		unsigned int b;
+
+		for (b = g; b < g + 4; b++) {
+			float c  = pThis->coeff[b];
+			float s1 = pThis->s1[b];
+			float s2 = pThis->s2[b];
+
+			for (i = 0; i < n; i++) {
+				float s0 = goertzel_frame(pSrc, i, channels) + c * s1 - s2;
+
+				s2 = s1;
+				s1 = s0;
+			}
+			pThis->s1[b] = s1;
+			pThis->s2[b] = s2;
+		}
+#endif
+	}
+}
+
+/* Block complete: powers out, states cleared */
+static void goertzel_finish(goertzel_t *pThis)
+{
+	unsigned int b;
+
+	for (b = 0; b < pThis->numBins; b++) {
+		float s1 = pThis->s1[b];
+		float s2 = pThis->s2[b];
+
+		pThis->power[b] = s1 * s1 + s2 * s2 - pThis->coeff[b] * s1 * s2;
+	}
+	pThis->blockEnergy = pThis->energy;
+
+	memset(pThis->s1, 0, sizeof(pThis->s1));
+	memset(pThis->s2, 0, sizeof(pThis->s2));
+	pThis->energy = 0.0f;
+	pThis->count  = 0;
+}
+
+/* Run the frames of a chunk through the bank */
+int goertzel_process(goertzel_t *pThis, const chunk_d_t *pChunk)
+{
+	const short *pSrc = pChunk->s16_buff;
+	unsigned int channels = (2 == pChunk->channels) ? 2 : 1;
+	unsigned int frames = pChunk->bytesUsed / sizeof(unsigned int) / channels;
+	int blocks = 0;
+
+	/* a chunk may end a block and start the next */
+	while (frames) {
+		unsigned int n = pThis->blockFrames - pThis->count;
+
+		if (n > frames) {
+			n = frames;
+		}
+		goertzel_run(pThis, pSrc, n, channels);
+		pThis->count += n;
+		pSrc         += n * channels;
+		frames       -= n;
+
+		if (pThis->count == pThis->blockFrames) {
+			goertzel_finish(pThis);
+			blocks++;
+		}
+	}
+	return blocks;
+}
+
+/* Amplitude of a bin: |X[k]| = A * N / 2 for a sine of amplitude A */
+unsigned int goertzel_amplitude(const goertzel_t *pThis, unsigned int bin)
+{
+	return (unsigned int) (2.0f * dspMath_sqrtf(pThis->power[bin]) / (float) pThis->blockFrames);
+}
+
+/* Share of the block energy: a sine on the bin has |X[k]|^2 = energy * N / 2 */
+float goertzel_ratio(const goertzel_t *pThis, unsigned int bin)
+{
+	if (pThis->blockEnergy <= 0.0f) {
+		return 0.0f;
+	}
+	return 2.0f * pThis->power[bin] / (pThis->blockEnergy * (float) pThis->blockFrames);
+}
+
+/* Initialize the bank for DTMF */
+int goertzel_dtmfInit(goertzel_t *pThis, unsigned int sampleRate, unsigned int blockFrames)
+{
+	return goertzel_init(pThis, goertzel_dtmfFreqs, GOERTZEL_DTMF_BINS, sampleRate, blockFrames);
+}
+
+/* strongest of four bins, 0 if it does not stand out */
+static int goertzel_dtmfPick(const goertzel_t *pThis, unsigned int first, unsigned int *pBin)
+{
+	unsigned int b, best = first;
+
+	for (b = first + 1; b < first + 4; b++) {
+		if (pThis->power[b] > pThis->power[best]) {
+			best = b;
+		}
+	}
+	for (b = first; b < first + 4; b++) {
+		if (b != best && pThis->power[b] * GOERTZEL_DTMF_GROUP_RATIO > pThis->power[best]) {
+			return 0;
+		}
+	}
+	*pBin = best;
+	return 1;
+}
+
+/* Decode the last block of a DTMF bank */
+char goertzel_dtmfKey(const goertzel_t *pThis)
+{
+	unsigned int row, col;
+	float rowRatio, colRatio;
+
+	if (!goertzel_dtmfPick(pThis, 0, &row) || !goertzel_dtmfPick(pThis, 4, &col)) {
+		return 0;
+	}
+
+	rowRatio = goertzel_ratio(pThis, row);
+	colRatio = goertzel_ratio(pThis, col);
+	if (rowRatio < GOERTZEL_DTMF_MIN_TONE || colRatio < GOERTZEL_DTMF_MIN_TONE
+			|| rowRatio + colRatio < GOERTZEL_DTMF_MIN_RATIO
+			|| rowRatio > colRatio * GOERTZEL_DTMF_TWIST || colRatio > rowRatio * GOERTZEL_DTMF_TWIST) {
+		return 0;
+	}
+
+	return goertzel_dtmfKeys[row][col - 4];
+}
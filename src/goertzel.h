@@ -0,0 +1,125 @@
+/**
+ *@file goertzel.h
+ *
+ *@brief
+ *  - Goertzel filter bank: power at a few chosen frequencies
+ *  - a block of blockFrames frames is collected across chunks of any
+ *    size, the coefficients depend on the block length only (each
+ *    frequency is rounded to the nearest DFT bin of the block)
+ *  - stereo chunks are analyzed as the (L+R)/2 downmix
+ *  - four bins per NEON iteration when built with -mfpu=neon
+ *  - tone detection on top: fraction of the block energy in a bin,
+ *    DTMF key decoding
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#ifndef _GOERTZEL_H_
+#define _GOERTZEL_H_
+
+#include "chunk_d.h"
+
+/***************************************************
+            DEFINES
+***************************************************/
+
+/** maximum number of bins (multiple of 4) */
+#define GOERTZEL_BINS_MAX  16
+
+/** DTMF: 4 row and 4 column tones */
+#define GOERTZEL_DTMF_BINS  8
+
+/***************************************************
+            DATA TYPES
+***************************************************/
+
+/** filter bank object */
+typedef struct {
+  unsigned int  numBins;
+  unsigned int  blockFrames;                 /* frames per block (N) */
+  unsigned int  count;                       /* frames in the current block */
+  float         coeff[GOERTZEL_BINS_MAX];    /* 2 cos(2 pi k / N) */
+  float         s1[GOERTZEL_BINS_MAX];       /* filter state */
+  float         s2[GOERTZEL_BINS_MAX];
+  float         energy;                      /* sum of x^2 of the current block */
+  float         power[GOERTZEL_BINS_MAX];    /* result of the last block */
+  float         blockEnergy;                 /* sum of x^2 of the last block */
+} goertzel_t;
+
+
+/***************************************************
+            Access Methods
+***************************************************/
+
+/** Initialize the bank
+ *
+ * Parameters:
+ * @param pThis         pointer to own object
+ * @param pFreqs        center frequencies in Hz
+ * @param numBins       number of frequencies (<= GOERTZEL_BINS_MAX)
+ * @param sampleRate    sample rate in Hz
+ * @param blockFrames   block length N in frames
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure.
+ */
+int goertzel_init(goertzel_t *pThis, const unsigned int *pFreqs, unsigned int numBins,
+		unsigned int sampleRate, unsigned int blockFrames);
+
+/** Run the frames of an S16 chunk through the bank
+ *   - mono as is, stereo as the (L+R)/2 downmix
+ *
+ * Parameters:
+ * @param pThis   pointer to own object
+ * @param pChunk  chunk to analyze
+ *
+ * @return number of blocks completed in this chunk (results in power[])
+ */
+int goertzel_process(goertzel_t *pThis, const chunk_d_t *pChunk);
+
+/** Amplitude of a bin of the last block
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ * @param bin    bin index
+ *
+ * @return sine amplitude in sample units (32768 = full scale)
+ */
+unsigned int goertzel_amplitude(const goertzel_t *pThis, unsigned int bin);
+
+/** Share of the last block's energy in a bin
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ * @param bin    bin index
+ *
+ * @return 0.0 .. 1.0 (1.0 = pure tone at the bin frequency)
+ */
+float goertzel_ratio(const goertzel_t *pThis, unsigned int bin);
+
+/** Initialize the bank for DTMF (697..941 Hz rows, 1209..1633 Hz columns)
+ *
+ * Parameters:
+ * @param pThis         pointer to own object
+ * @param sampleRate    sample rate in Hz
+ * @param blockFrames   block length in frames, >= 40 ms worth for 73 Hz tone spacing
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure.
+ */
+int goertzel_dtmfInit(goertzel_t *pThis, unsigned int sampleRate, unsigned int blockFrames);
+
+/** Decode the last block of a DTMF bank
+ *
+ * Parameters:
+ * @param pThis  bank set up with goertzel_dtmfInit()
+ *
+ * @return key ('0'-'9', '*', '#', 'A'-'D'), 0 if none
+ */
+char goertzel_dtmfKey(const goertzel_t *pThis);
+
+#endif
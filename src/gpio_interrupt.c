@@ -18,8 +18,11 @@
 
 
 #include "zedboard_freertos.h"
+#include "appConfig.h"
 #include "gpio_interrupt.h"
 #include "audioPlayer.h"
+#include "gpio_ttc.h"
+#include "uiEvents.h"
 #include <stdbool.h>
 #include <stdio.h>
 
@@ -29,19 +32,86 @@ static void gpio_intrHandler(void *pRef);
 /* setup interrupt connection */
 static int gpio_setupInts(void);
 
-/* Define QueueHandle */
-QueueHandle_t gCountUpdateQ;
+/* GPIO task, target of the button notifications */
+static TaskHandle_t gpio_taskHandle;
+
+/* debounce state of one button */
+typedef struct {
+	u32				mask;		/* pin in bank 2 */
+	uint32_t		event;		/* UI_EVT_xxx sent to the GPIO task */
+	int				direction;	/* volume step sign */
+	TimerHandle_t	timer;		/* settle / auto-repeat timer */
+	unsigned int	repeats;	/* auto-repeats while held */
+	volatile int	steps;		/* volume steps not yet applied */
+	APP_TIMER_STORAGE(timer)
+} gpio_button_t;
+
+static gpio_button_t gpio_buttons[] = {
+	{ .mask = GPIO_BTN_UP,   .event = UI_EVT_VOL_UP,   .direction =  1 },
+	{ .mask = GPIO_BTN_DOWN, .event = UI_EVT_VOL_DOWN, .direction = -1 },
+};
+#define GPIO_BTN_NUM (sizeof(gpio_buttons) / sizeof(gpio_buttons[0]))
+
+/* settle / auto-repeat timer of a button */
+static void gpio_buttonTimer(TimerHandle_t timer);
+
+/* take the pending volume steps of a button */
+static int gpio_takeSteps(gpio_button_t *pBtn)
+{
+	int steps;
+
+	taskENTER_CRITICAL();
+	steps = pBtn->steps;
+	pBtn->steps = 0;
+	taskEXIT_CRITICAL();
+	return steps;
+}
 
 /* Define AudioPlayer */
 audioPlayer_t *gAudioPlayer;
 
+/* runtime statistics on the console every GPIO_STATS_MS */
+static void gpio_statsService(void)
+{
+	static TickType_t last = 0;
+	TickType_t now = xTaskGetTickCount();
+
+	if (now - last < GPIO_STATS_MS / portTICK_PERIOD_MS) {
+		return;
+	}
+	last = now;
+
+	bufferPool_d_printStats(&gAudioPlayer->bp, "audio");
+	ttc_printStats();
+}
+
+/* both volume buttons held: save one recorder snapshot per hold (the
+ * up and down steps of the chord cancel out) */
+static void gpio_snapshotService(void)
+{
+	static int held = 0;
+	static unsigned int count = 0;
+	char path[GPIO_SNAP_PATH_LEN];
+
+	if (GPIO_BTNS != ((* (volatile u32 *) GPIO_DATA_RO_2) & GPIO_BTNS)) {
+		held = 0;
+		return;
+	}
+	if (held) {
+		return;
+	}
+	held = 1;
+
+	snprintf(path, sizeof(path), GPIO_SNAP_PATH, count++);
+	audioPlayer_snapshot(gAudioPlayer, path);
+}
+
 /* GPIO Task */
 static void gpio_task( void *pvParameters )
 {
-	// Pointer to the volume update flag
-	int *volChangePtr;
-	// Holder for the value of the volume update flag
-	int volChange;
+	// Button events since the last wakeup
+	uint32_t events;
+	unsigned int i;
 
 	/* setup interrupts
 	 * Note: needs to be called in task context as GIC is initialized
@@ -49,31 +119,31 @@ static void gpio_task( void *pvParameters )
 	 */
 	gpio_setupInts();
 	
-	/* Create a queue capable of containing 10 unsigned long values. */
-	gCountUpdateQ = xQueueCreate(10, sizeof(int));
-	if (gCountUpdateQ == 0)
-	{
-		printf("ERROR CREATING QUEUE.");
-	}
-	else
-	{
-		printf("Queue Created.\n");
-	}
-	
 	for(;;){
-		// Receive the volume update flag from Queue
-		if( xQueueReceive(gCountUpdateQ, &( volChangePtr), ( TickType_t )1000) )
+		// Wait for button events, presses meanwhile are merged
+		if( pdTRUE == xTaskNotifyWait(0, UI_EVT_ALL, &events, GPIO_SERVICE_MS / portTICK_PERIOD_MS) )
 		{
-			volChange = (int)volChangePtr;
-			// If flag set high, increase volume
-			if(volChange){
-				audioPlayer_volumeIncrease(gAudioPlayer);
-			}
-			// Else, decrease volume
-			else{
-				audioPlayer_volumeDecrease(gAudioPlayer);
+			// Volume up/down, several steps per event when held
+			for (i = 0; i < GPIO_BTN_NUM; i++) {
+				if (events & gpio_buttons[i].event) {
+					audioPlayer_volumeStep(gAudioPlayer, gpio_buttons[i].direction * gpio_takeSteps(&gpio_buttons[i]));
+				}
 			}
+			// show the change without waiting for the next frame
+			ttc_refresh();
 		}
+
+		// Input PGA step requested by the AGC (codec registers are written from this task only)
+		audioPlayer_agcService(gAudioPlayer);
+
+		// Recorder snapshot on the up+down chord
+		gpio_snapshotService();
+
+		// Stages shed by the audio deadline watchdog
+		audioWatchdog_report(&gAudioPlayer->watchdog);
+
+		// Pool and UI job statistics
+		gpio_statsService();
 	}
 
 
@@ -102,6 +172,8 @@ static int gpio_setupInts(void) {
 
 /**
  * Function that is called when an interrupt happens
+ *  - first edge of a press: mask the pin and let the timer sample it
+ *    once it settled, bounce edges do not interrupt again
  *
  * Parameters:
  *
@@ -109,50 +181,71 @@ static int gpio_setupInts(void) {
  */
 static void gpio_intrHandler(void *pRef)
 {
-	// Initialize flag for signaling a volume update is required
-	static int flag = 0;
-	
-	// Initialize ints for holding the time of the last button pushes
-	static uint32_t lastTimeUp = 0;
-	static uint32_t lastTimeDown = 0;
+	BaseType_t woken = pdFALSE;
+	unsigned int i;
 
-	//Get Current Time
-	uint32_t currentTime = xTaskGetTickCountFromISR();
+	/* Read interrupt status of the button pins */
+	u32 status = (* (volatile u32 *) GPIO_INT_STAT_2) & GPIO_BTNS;
 
-	/* Read interrupt status of the GPIO pins */
-	u8 button_Ints = (* (u32 *) GPIO_INT_STAT_2) >> 16;
-	
-	// Clear interrupts
-	(* (u32 *) GPIO_INT_STAT_2) &= 0xffffffff;
-
-    // Save GPIO input data for comparison
-	u32 temp = *(u32 *)GPIO_DATA_RO_2;
-    
-    // If down button pressed and enough time has passed
-	if ((currentTime > lastTimeDown + 20) && (button_Ints & 0b100) && !(temp >> 16 & 0x40000 ) )
-	{
-		// Update Stored Time Value
-		lastTimeDown = currentTime;
-		
-		// Update flag for decrease
-		flag = 0;
-		
-		/* Send the counter value to Queue */
-		xQueueSendFromISR( gCountUpdateQ,( void * ) &flag, NULL);
+	// Clear interrupts (write one to clear)
+	(* (volatile u32 *) GPIO_INT_STAT_2) = status;
+
+	for (i = 0; i < GPIO_BTN_NUM; i++) {
+		gpio_button_t *pBtn = &gpio_buttons[i];
+
+		if (status & pBtn->mask) {
+			// mask the pin until the timer has sampled it
+			(* (volatile u32 *) GPIO_INT_DIS_2) = pBtn->mask;
+			pBtn->repeats = 0;
+			if (pdPASS != xTimerChangePeriodFromISR(pBtn->timer, GPIO_DEBOUNCE_MS / portTICK_PERIOD_MS, &woken)) {
+				// timer queue full: no callback would unmask the pin, keep listening
+				(* (volatile u32 *) GPIO_INT_EN_2) = pBtn->mask;
+			}
+		}
+	}
+
+	portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * Timer callback (timer service task): sample a button after it settled
+ *  - still pressed: count a press, re-arm for auto-repeat with a growing
+ *    number of volume steps per repeat
+ *  - released (or only a glitch): unmask the pin for the next press
+ *
+ * Parameters:
+ * @param timer  timer of the button (ID = gpio_button_t)
+ *
+ * @return void
+ */
+static void gpio_buttonTimer(TimerHandle_t timer)
+{
+	gpio_button_t *pBtn = (gpio_button_t *) pvTimerGetTimerID(timer);
+	int steps;
+
+	if (!((* (volatile u32 *) GPIO_DATA_RO_2) & pBtn->mask)) {
+		// drop edges of the release bounce, then listen again
+		(* (volatile u32 *) GPIO_INT_STAT_2) = pBtn->mask;
+		(* (volatile u32 *) GPIO_INT_EN_2) = pBtn->mask;
+		return;
 	}
 
-	// If up button pressed and enough time has passed
-	if((currentTime > lastTimeUp + 20) && (button_Ints & 0b10000) && !(temp >> 16 & 0x100000 ) )
-	{
-		// Update Stored Time Value
-		lastTimeUp = currentTime;
-		
-		// Update flag for increase
-		flag = 1;
-
-		/* Send the counter value to Queue */
-		xQueueSendFromISR( gCountUpdateQ,( void * ) &flag, NULL);
+	if (pBtn->repeats < GPIO_ACCEL_REPEATS_1) {
+		steps = 1;
+	} else if (pBtn->repeats < GPIO_ACCEL_REPEATS_2) {
+		steps = 2;
+	} else {
+		steps = 4;
 	}
+
+	taskENTER_CRITICAL();
+	pBtn->steps += steps;
+	taskEXIT_CRITICAL();
+	xTaskNotify(gpio_taskHandle, pBtn->event, eSetBits);
+
+	// first press waits longer before repeating
+	xTimerChangePeriod(timer, (pBtn->repeats ? GPIO_REPEAT_MS : GPIO_REPEAT_DELAY_MS) / portTICK_PERIOD_MS, 0);
+	pBtn->repeats++;
 }
 
 
@@ -165,6 +258,7 @@ static void gpio_intrHandler(void *pRef)
  * @return void
  */
 void gpio_init(audioPlayer_t *audioPlayer) {
+	unsigned int i;
 
 	/* OutEnable for LEDs  */
 	//* (volatile u32 *)GPIO_DIRM_2 |= 0b11111111;
@@ -173,12 +267,18 @@ void gpio_init(audioPlayer_t *audioPlayer) {
 	/* disable interrupts before configuring new ints */
 	* (volatile u32 *)GPIO_INT_DIS_2 = 0xffffffff;
 
-	* (volatile u32 *)GPIO_INT_TYPE_2 = 0x140000; // edge-sensitive - Only Up/Down Buttons
-	* (volatile u32 *)GPIO_INT_POLARITY_2 = 0x140000; // rising-edge
+	* (volatile u32 *)GPIO_INT_TYPE_2 = GPIO_BTNS; // edge-sensitive - Only Up/Down Buttons
+	* (volatile u32 *)GPIO_INT_POLARITY_2 = GPIO_BTNS; // rising-edge
 	* (volatile u32 *)GPIO_INT_ANY_2 = 0; // only rising-edge
 
+	/* settle / auto-repeat timers, started by the interrupt */
+	for (i = 0; i < GPIO_BTN_NUM; i++) {
+		gpio_buttons[i].timer = APP_TIMER_CREATE(&gpio_buttons[i], timer, "BTN",
+				GPIO_DEBOUNCE_MS / portTICK_PERIOD_MS, pdFALSE, &gpio_buttons[i], gpio_buttonTimer);
+	}
+
 	/* enable input bits */
-	* (volatile u32 *)GPIO_INT_EN_2 = 0x140000;
+	* (volatile u32 *)GPIO_INT_EN_2 = GPIO_BTNS;
 
 	/* disable LEDs on startup */
 	//*(u8 *)GPIO_DATA_2 &= 0b00000000;
@@ -195,7 +295,7 @@ void gpio_init(audioPlayer_t *audioPlayer) {
  */
 void gpio_start(void)
 {
-	xTaskCreate( gpio_task, ( signed char * ) "HW", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1 , NULL );
+	gpio_taskHandle = APP_TASK_CREATE_LOCAL( gpio_task, "GPIO", GPIO_TASK_STACK, NULL, GPIO_TASK_PRIO );
 }
 
 
@@ -139,6 +139,31 @@ Reading from this register returns an unpredictable value.
  */
 #define GPIO_EXIT_CONTROL_VALUE	0x1F
 
+/* Volume buttons on EMIO bank 2, high while pressed */
+#define GPIO_BTN_DOWN	(1 << 18)
+#define GPIO_BTN_UP		(1 << 20)
+#define GPIO_BTNS		(GPIO_BTN_DOWN | GPIO_BTN_UP)
+
+/* Debounce and auto-repeat timing (ms) */
+#define GPIO_DEBOUNCE_MS		20	/* settle time after the first edge */
+#define GPIO_REPEAT_DELAY_MS	500	/* hold time before auto-repeat starts */
+#define GPIO_REPEAT_MS			100	/* auto-repeat interval */
+
+/* GPIO task wakeup without button events: input PGA writes of the AGC,
+ * snapshot chord, watchdog report, statistics (ms) */
+#define GPIO_SERVICE_MS			50
+
+/* Buffer pool and UI scheduler statistics printed by the GPIO task (ms) */
+#define GPIO_STATS_MS			10000
+
+/* Recorder snapshot (both buttons held): file name, numbered per boot */
+#define GPIO_SNAP_PATH			"snap%u.wav"
+#define GPIO_SNAP_PATH_LEN		20
+
+/* Auto-repeat acceleration: volume steps per repeat after n repeats */
+#define GPIO_ACCEL_REPEATS_1	4	/* below: 1 step */
+#define GPIO_ACCEL_REPEATS_2	12	/* below: 2 steps, above: 4 steps */
+
 //#define printf			xil_printf	/* Smalller foot-print printf */
 
 /**************************** Type Definitions *******************************/
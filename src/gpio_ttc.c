@@ -1,5 +1,13 @@
 #include "zedboard_freertos.h"
-#include "gpio_pwm.h"
+#include "appConfig.h"
+#include "gpio_ttc.h"
+#include "uiEvents.h"
+#include "sysMonitor.h"
+#include "oled.h"
+#include "meter.h"
+#include "uiSched.h"
+
+APP_STATIC_ASSERT(METER_BAND_NUM == OLED_BAND_NUM, one_meter_per_oled_band);
 
 /* user TTC Interrupt handler */
 static void ttc_intrHandler(void *pRef);
@@ -7,34 +15,96 @@ static void ttc_intrHandler(void *pRef);
 /* setup interrupt connection */
 static int ttc_setupInt(void);
 
-/* Define QueueHandle */
-QueueHandle_t tCountUpdateQ;
+/* Display task, target of the refresh notifications */
+static TaskHandle_t ttc_taskHandle;
 
-static void ttc_task( void *pvParameters )
+/* Audio player the levels come from */
+static audioPlayer_t *tAudioPlayer;
+
+/* Ballistics between the analyzer levels and the bars */
+static meter_t ttc_meter;
+
+/* UI jobs */
+static uiSched_t ttc_sched;
+
+/* base ticks since start, counted by the interrupt */
+static volatile uint32_t ttc_ticks;
+
+APP_STATIC_ASSERT(UI_TICK_HZ % UI_METER_HZ == 0 && UI_TICK_HZ % UI_STATUS_HZ == 0
+		&& UI_TICK_HZ % UI_FLUSH_HZ == 0, ui_rates_divide_tick);
+
+/* Job: levels -> meter -> bars in the framebuffer */
+static void ttc_meterJob(void *pArg)
 {
-	// Setup the interrupt
-	ttc_setupInt();
-	
-	// Pointer to the volume update flag
-	int *oledUpdatePtr;
-	
-	/* Create a queue capable of containing 10 unsigned long values. */
-	gCountUpdateQ = xQueueCreate(10, sizeof(int));
-	if (gCountUpdateQ == 0)
-	{
-		printf("ERROR CREATING QUEUE.");
+	uint32_t levels[METER_BAND_NUM];
+	uint32_t bars[METER_BAND_NUM];
+	uint32_t peaks[METER_BAND_NUM];
+
+	/* shed by the audio watchdog: bars hold until it is restored */
+	if (!audioWatchdog_enabled(&tAudioPlayer->watchdog, AUDIOWD_STAGE_METERS)) {
+		return;
 	}
-	else
-	{
-		printf("Queue Created.\n");
+
+	audioPlayer_getLevels(tAudioPlayer, levels);
+	meter_frame(&ttc_meter, levels);
+	meter_getBars(&ttc_meter, bars, peaks, OLED_BAR_MAX);
+	oled_updateDisplay(bars, peaks);
+}
+
+#if SYSMON_ENABLED
+/* Job: CPU load line */
+static void ttc_statusJob(void *pArg)
+{
+	oled_updateLoad(sysMonitor_getLoad());
+}
+#endif
+
+/* Job: send what changed to the display */
+static void ttc_flushJob(void *pArg)
+{
+	oled_flush();
+}
+
+/* audio is shedding work or the CPU is nearly full: leave it the time */
+static int ttc_busy(void)
+{
+#if SYSMON_ENABLED
+	if (sysMonitor_getLoad() > UI_BUSY_PERMILLE) {
+		return 1;
 	}
+#endif
+	return tAudioPlayer->watchdog.stages != AUDIOWD_STAGE_ALL;
+}
+
+static void ttc_task( void *pvParameters )
+{
+	uint32_t events;
+
+	// Jobs in run order, flush last
+	uiSched_init(&ttc_sched);
+	meter_init(&ttc_meter, METER_MODE_PPM, UI_METER_HZ);
+	uiSched_add(&ttc_sched, "meter", ttc_meterJob, NULL, UI_TICK_HZ / UI_METER_HZ,
+			UI_METER_BUDGET_US, UISCHED_OPTIONAL);
+#if SYSMON_ENABLED
+	uiSched_add(&ttc_sched, "status", ttc_statusJob, NULL, UI_TICK_HZ / UI_STATUS_HZ,
+			UI_STATUS_BUDGET_US, UISCHED_OPTIONAL);
+#endif
+	uiSched_add(&ttc_sched, "flush", ttc_flushJob, NULL, UI_TICK_HZ / UI_FLUSH_HZ,
+			UI_FLUSH_BUDGET_US, UISCHED_OPTIONAL);
+
+	// Setup the interrupt (task handle is known now)
+	ttc_setupInt();
 	
 	for(;;){
-		// Receive the volume update flag from Queue
-		if( xQueueReceive(tCountUpdateQ, &(oled_updatePtr), ( TickType_t )1000) )
+		// Wait for base ticks, ticks arriving meanwhile are merged
+		if( pdTRUE == xTaskNotifyWait(0, UI_EVT_ALL, &events, ( TickType_t )1000) )
 		{
-			uint32_t * levelData = audioPlayer_getLevels();
-			oled_updateDisplay(levelData);
+			uint32_t now = ttc_ticks;
+
+			if (events & UI_EVT_REDRAW) {
+				uiSched_trigger(&ttc_sched, now);
+			}
+			uiSched_run(&ttc_sched, now, ttc_busy());
 		}
 	}
 	
@@ -50,10 +120,10 @@ static int ttc_setupInt(void) {
 	// get pointer to GIC (already initialized at OS startup)
 	pGIC = prvGetInterruptControllerInstance();
 	// connect own interrupt handler to GIC handler
-	XScuGic_Connect(pGIC, GPIO_INTERRUPT_ID,
-	(Xil_ExceptionHandler) ttc_intrHandler,(void *) NULL);											// Need to find timer interrupt ID (XParameters.h)
+	XScuGic_Connect(pGIC, TTC_INTERRUPT_ID,
+	(Xil_ExceptionHandler) ttc_intrHandler,(void *) NULL);
 	// Enable interrupt at GIC
-	XScuGic_Enable(pGIC, GPIO_INTERRUPT_ID);
+	XScuGic_Enable(pGIC, TTC_INTERRUPT_ID);
 	/* Enable IRQ at core (should be enabled anyway)*/
 	Xil_ExceptionEnableMask(XIL_EXCEPTION_IRQ);
 
@@ -62,39 +132,59 @@ static int ttc_setupInt(void) {
 
 static void ttc_intrHandler(void *pRef)
 {
-	// Clear interrupt
-	(* (uint8_t *) TTC_T0_INT_STATUS) &= 0b11111110; 												// does this addressing make sense? it's an 8-bit wide register
+	BaseType_t woken = pdFALSE;
+
+	// Clear interrupt (status register clears on read)
+	(void) *(volatile uint32_t *) TTC0_T0_INT_STATUS;
 	
-	int flag = 1;
-	xQueueSendFromISR( tCountUpdateQ,( void * ) &flag, NULL);
+	ttc_ticks++;
+
+	// Set the tick bit, a tick still pending absorbs this one
+	xTaskNotifyFromISR(ttc_taskHandle, UI_EVT_REFRESH, eSetBits, &woken);
+	portYIELD_FROM_ISR(woken);
 }
 
-void ttc_init(void)
+void ttc_init(audioPlayer_t *pAudioPlayer)
 {
 	uint32_t ClockCntrl, CounterCntrl ,Period;
+	uint32_t prescale = 0;
+
+	tAudioPlayer = pAudioPlayer;
 
-																									/* Need to determine prescaler value */
+	// Smallest prescaler that fits the interval into 16 bits
+	while (prescale < TTC_PRESCALE_MAX
+			&& XPAR_XTTCPS_0_CLOCK_HZ / (2u << prescale) / UI_TICK_HZ > TTC_INTERVAL_MAX) {
+		prescale++;
+	}
+	Period = XPAR_XTTCPS_0_CLOCK_HZ / (2u << prescale) / UI_TICK_HZ;
 	
-	//Set Clock Control 7bits, Enable Prescaler(Bit0) and give the Prescaler Value(Bit4:0)
-	ClockCntrl =  0b0001011;
+	//Set Clock Control 7bits, Enable Prescaler(Bit0) and give the Prescaler Value(Bit4:1)
+	ClockCntrl = (prescale << 1) | 1;
 	*((volatile uint32_t*)(SET_CLK_CNTRL_VAL)) = ClockCntrl;
 
 	/* Set Counter Control 7bits, Wave_pol(Bit6), Wave_en(Bit5), RST(Bit4), Match(Bit3), DEC(Bit2), INT(Bit1), DIS(Bit0) */
 	CounterCntrl = 0b1110010;
 	*((volatile uint32_t*)(SET_CNT_CNTRL_VAL)) = CounterCntrl;
 	
-	Period = 165812;
-	*((volatile uint32_t*)(SET_INTERVAL_VAL)) = Period;												/* Need to determine interval value (update freq) */
-	
-	uint8_t intEn = (* (uint32_t *) TTC_T0_INT_EN);
+	*((volatile uint32_t*)(SET_INTERVAL_VAL)) = Period;
 	
 	// Enable interval interrupt for TTC0
-	(* (uint32_t *) TTC_T0_INT_EN) |= 0b00000001;
+	(* (volatile uint32_t *) TTC0_T0_INT_EN) |= 0b00000001;
 	
 }
 
 void ttc_start(void)
 {
 	//Create a task. This task can be removed if there isn't a need to run any tasks.
-	xTaskCreate( ttc_task, ( signed char * ) "HW", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1 , NULL );
+	ttc_taskHandle = APP_TASK_CREATE_LOCAL( ttc_task, "TTC", TTC_TASK_STACK, NULL, TTC_TASK_PRIO );
+}
+
+void ttc_refresh(void)
+{
+	xTaskNotify(ttc_taskHandle, UI_EVT_REDRAW, eSetBits);
+}
+
+void ttc_printStats(void)
+{
+	uiSched_printStats(&ttc_sched);
 }
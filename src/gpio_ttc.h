@@ -15,30 +15,58 @@
  *******************************************************************************/
 #ifndef GPIO_TTC_H_
 #define GPIO_TTC_H_
-/** gpio_init
+#include "audioPlayer.h"
+
+/** UI base tick, TTC0 timer 0 interval interrupt */
+#define UI_TICK_HZ 120
+
+/** UI job rates in Hz (divisors of UI_TICK_HZ) */
+#define UI_METER_HZ   30  /* levels -> meter ballistics -> framebuffer */
+#define UI_STATUS_HZ   4  /* CPU load line (SYSMON_ENABLED only) */
+#define UI_FLUSH_HZ   30  /* framebuffer -> display */
+
+/** UI job budgets in us */
+#define UI_METER_BUDGET_US    200
+#define UI_STATUS_BUDGET_US    50
+#define UI_FLUSH_BUDGET_US   2000
+
+/** CPU load (1/1000) above which the display jobs are skipped (SYSMON_ENABLED only) */
+#define UI_BUSY_PERMILLE 850
+
+/** ttc_init
  *
- * Initialization of PORTFIO. This PORT is used as GPIO.
- * The output and input direction can be set using the MACROS
+ * Program TTC0 timer 0 for the UI base tick (UI_TICK_HZ)
  *
  * Parameters:
+ * @param pAudioPlayer  audio player the meter levels come from
  *
  * @return void
  */
-void gpio_init(void);
+void ttc_init(audioPlayer_t *pAudioPlayer);
 
-/** gpio_init
+/** ttc_start
  *
- * The main command loop. Write all the control commands in this function
- *
- * Parameters:
+ * Create the UI task (runs the UI jobs on the base tick)
  *
  * @return void
  */
-void gpio_run(void);
+void ttc_start(void);
 
+/** ttc_refresh
+ *
+ * Run all UI jobs on the next base tick (task context)
+ *
+ * @return void
+ */
+void ttc_refresh(void);
 
-void ttc_init(void);
-void ttc_start(void);
+/** ttc_printStats
+ *
+ * Print the UI scheduler job statistics (task context)
+ *
+ * @return void
+ */
+void ttc_printStats(void);
 
 /************************** Constant Definitions *****************************/
 
@@ -52,8 +80,11 @@ void ttc_start(void);
 
 // /** Base address for TTC0 peripherals*/
 #define TTC0_T0_BASE 0xF8001000
-#define TTC0_T0_INT_STATUS  TTC0_T0_BASE + 0x54
-#define TTC0_T0_INT_EN		TTC0_T0_BASE + 0x60
+
+/** GIC interrupt of TTC0 timer 0 */
+#define TTC_INTERRUPT_ID XPS_TTC0_0_INT_ID
+#define TTC0_T0_INT_STATUS (TTC0_T0_BASE + 0x54)
+#define TTC0_T0_INT_EN     (TTC0_T0_BASE + 0x60)
 
 /******** Set Clock Control Definition ********************/
 #define SET_CLK_CNTRL_VAL (TTC0_T0_BASE + 0x00000000U)  /**< Clock Control Register*/
@@ -68,6 +99,10 @@ that the counter will count up to or down from.
 */
 #define SET_INTERVAL_VAL (TTC0_T0_BASE + 0x24)  /**< Interval Count Value */
 
+/* Interval counter is 16 bits wide, prescaler divides by 2^(N+1), N < 16 */
+#define TTC_INTERVAL_MAX  0xFFFF
+#define TTC_PRESCALE_MAX  15
+
 #endif /* GPIO_PWM_H_ */
 
 
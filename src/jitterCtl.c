@@ -0,0 +1,93 @@
+/**
+ *@file jitterCtl.c
+ *
+ *@brief
+ *  - adaptive jitter buffer control for the TX queue
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#include <string.h>
+#include "jitterCtl.h"
+
+/* Initialize the controller */
+void jitterCtl_init(jitterCtl_t *pThis, unsigned int margin)
+{
+	memset(pThis, 0, sizeof(*pThis));
+	pThis->margin  = margin;
+	pThis->target  = margin;
+	pThis->curMin  = ~0u;
+	pThis->enabled = 1;
+}
+
+/* Record the queue fill, plan the correction at the window end */
+void jitterCtl_observe(jitterCtl_t *pThis, unsigned int fill, unsigned int frames)
+{
+	if (fill < pThis->curMin) {
+		pThis->curMin = fill;
+	}
+	if (fill > pThis->curMax) {
+		pThis->curMax = fill;
+	}
+
+	if (++pThis->count < JITTER_WINDOW) {
+		return;
+	}
+
+	/* a window may swing as far below its lowest fill as the last one
+	 * swung: keep that much in the queue, forget old swings slowly */
+	if (pThis->curMax - pThis->curMin >= pThis->jitter) {
+		pThis->jitter = pThis->curMax - pThis->curMin;
+	} else {
+		pThis->jitter--;
+	}
+	pThis->target = (pThis->jitter > pThis->margin) ? pThis->jitter : pThis->margin;
+
+	/* lowest fill above the target is latency nobody needs - drop it */
+	pThis->adjust = 0;
+	if (pThis->curMin > pThis->target) {
+		pThis->adjust = (pThis->curMin - pThis->target) * frames;
+	}
+
+	/* no more than one window worth of corrections */
+	if (pThis->adjust > JITTER_WINDOW * JITTER_MAX_STEP) {
+		pThis->adjust = JITTER_WINDOW * JITTER_MAX_STEP;
+	}
+
+	pThis->count  = 0;
+	pThis->curMin = ~0u;
+	pThis->curMax = 0;
+}
+
+/* Drop frames from a chunk */
+void jitterCtl_apply(jitterCtl_t *pThis, chunk_d_t *pChunk)
+{
+	short *pS = pChunk->s16_buff;
+	unsigned int n = pChunk->bytesUsed / sizeof(unsigned int) / JITTER_CHANNELS;
+	unsigned int k, j, p, c;
+
+	if (!pThis->enabled || 0 == pThis->adjust || n < 2 * JITTER_MAX_STEP + 2) {
+		return;
+	}
+
+	/* merge a frame into its predecessor (per channel), spread over the chunk */
+	k = (pThis->adjust < JITTER_MAX_STEP) ? pThis->adjust : JITTER_MAX_STEP;
+	for (j = k; j > 0; j--) {
+		p = (j * n) / (k + 1);
+		for (c = 0; c < JITTER_CHANNELS; c++) {
+			pS[(p - 1) * JITTER_CHANNELS + c] =
+					(pS[(p - 1) * JITTER_CHANNELS + c] + pS[p * JITTER_CHANNELS + c]) / 2;
+		}
+		memmove(&pS[p * JITTER_CHANNELS], &pS[(p + 1) * JITTER_CHANNELS],
+				(n - p - 1) * JITTER_CHANNELS * sizeof(short));
+		n--;
+	}
+	pThis->adjust  -= k;
+	pThis->dropped += k;
+
+	pChunk->bytesUsed = n * JITTER_CHANNELS * sizeof(unsigned int);
+}
@@ -0,0 +1,106 @@
+/**
+ *@file jitterCtl.h
+ *
+ *@brief
+ *  - adaptive jitter buffer control for the TX queue
+ *  - tracks the TX queue fill over a window of chunks and steers the
+ *    lowest fill seen towards a target of the observed jitter (fill
+ *    peak-to-peak, at least the margin), so the queue only holds as
+ *    much audio as the jitter needs
+ *  - the jitter estimate follows a larger swing at once and decays by
+ *    one chunk per window
+ *  - converges by dropping a few L/R frames per chunk (each dropped
+ *    frame is averaged into its neighbour per channel, at most
+ *    JITTER_MAX_STEP frames per chunk)
+ *  - a fill below the margin is not stretched: RX chunks are full, and
+ *    an underrun re-primes the TX FIFO anyway
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#ifndef _JITTER_CTL_H_
+#define _JITTER_CTL_H_
+
+#include "chunk_d.h"
+
+/***************************************************
+            DEFINES
+***************************************************/
+
+/**
+ * @def JITTER_WINDOW
+ * @brief chunks per statistics window
+ */
+#define JITTER_WINDOW 64
+
+/**
+ * @def JITTER_MARGIN
+ * @brief default lower bound of the target fill (chunks)
+ */
+#define JITTER_MARGIN 1
+
+/**
+ * @def JITTER_MAX_STEP
+ * @brief max frames dropped per chunk
+ */
+#define JITTER_MAX_STEP 2
+
+/**
+ * @def JITTER_CHANNELS
+ * @brief slots per frame (interleaved L,R)
+ */
+#define JITTER_CHANNELS 2
+
+/***************************************************
+            DATA TYPES
+***************************************************/
+
+/** jitter controller object */
+typedef struct {
+  unsigned int count;       /* chunks observed in the current window */
+  unsigned int curMin;      /* lowest fill in the current window */
+  unsigned int curMax;      /* highest fill in the current window */
+  unsigned int margin;      /* lower bound of the target (chunks) */
+  unsigned int jitter;      /* fill peak-to-peak, decaying peak over windows */
+  unsigned int target;      /* lowest fill aimed for: max(margin, jitter) */
+  unsigned int adjust;      /* frames still to drop */
+  unsigned int dropped;     /* frames dropped so far */
+  int          enabled;     /* controller active */
+} jitterCtl_t;
+
+
+/***************************************************
+            Access Methods
+***************************************************/
+
+/** Initialize the controller
+ *
+ * Parameters:
+ * @param pThis   pointer to own object
+ * @param margin  lower bound of the target fill (chunks)
+ */
+void jitterCtl_init(jitterCtl_t *pThis, unsigned int margin);
+
+/** Record the queue fill seen before queueing a chunk,
+ *  plan the correction at the end of every window
+ *
+ * Parameters:
+ * @param pThis    pointer to own object
+ * @param fill     chunks currently queued
+ * @param frames   L/R frames in a chunk
+ */
+void jitterCtl_observe(jitterCtl_t *pThis, unsigned int fill, unsigned int frames);
+
+/** Drop frames from a chunk about to be queued
+ *
+ * Parameters:
+ * @param pThis   pointer to own object
+ * @param pChunk  chunk (16 bit samples, one per 32 bit word, interleaved L,R)
+ */
+void jitterCtl_apply(jitterCtl_t *pThis, chunk_d_t *pChunk);
+
+#endif
@@ -0,0 +1,160 @@
+/**
+ *@file latencyProbe.c
+ *
+ *@brief
+ *  - end-to-end latency measurement with an injected marker
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#include <string.h>
+#include "latencyProbe.h"
+#include "zedboard_freertos.h"
+
+#define HIST_LEN (LATENCY_MARKER_LEN - 1)
+
+/* L/R downmix of a frame */
+#define DOWNMIX(pS, f) ((short) (((int) (pS)[LATENCY_CHANNELS * (f)] + (pS)[LATENCY_CHANNELS * (f) + 1]) / 2))
+
+/* Initialize the probe */
+void latencyProbe_init(latencyProbe_t *pThis)
+{
+	unsigned int lfsr = 1;
+	int i;
+
+	memset(pThis, 0, sizeof(*pThis));
+
+	/* MLS from x^6 + x^5 + 1, flat spectrum and a single correlation peak */
+	for (i = 0; i < LATENCY_MARKER_LEN; i++) {
+		unsigned int bit = ((lfsr >> 5) ^ (lfsr >> 4)) & 1;
+		pThis->marker[i] = (lfsr & 1) ? LATENCY_MARKER_AMP : -LATENCY_MARKER_AMP;
+		lfsr = ((lfsr << 1) | bit) & 0x3F;
+		pThis->markerEnergy += (long long) pThis->marker[i] * pThis->marker[i];
+	}
+
+	pThis->state = LATENCY_IDLE;
+}
+
+/* Start a measurement */
+void latencyProbe_start(latencyProbe_t *pThis)
+{
+	pThis->txPos = 0;
+	pThis->state = LATENCY_ARMED;
+}
+
+/* Feed a received chunk */
+void latencyProbe_rx(latencyProbe_t *pThis, const chunk_d_t *pChunk)
+{
+	const short *pS = pChunk->s16_buff;
+	int n = pChunk->bytesUsed / sizeof(unsigned int) / LATENCY_CHANNELS;
+	float best = 0.25f; /* normalized correlation^2 threshold (0.5) */
+	int found = -1;
+	int i, j;
+
+	pThis->rxChunkStart = pThis->rxCount;
+	pThis->rxCount     += n;
+
+	if (LATENCY_WAITING != pThis->state) {
+		return;
+	}
+
+	/* slide the marker over [last HIST_LEN frames | this chunk], any chunk length */
+	for (i = 0; i < n; i++) {
+		long long corr = 0, energy = 0;
+
+		for (j = 0; j < LATENCY_MARKER_LEN; j++) {
+			int k = i + j;
+			short x = (k < HIST_LEN) ? pThis->hist[k] : DOWNMIX(pS, k - HIST_LEN);
+			corr   += (long long) x * pThis->marker[j];
+			energy += (long long) x * x;
+		}
+
+		if (corr > 0 && energy > 0) {
+			float norm = ((float) corr * (float) corr) / ((float) energy * (float) pThis->markerEnergy);
+			if (norm > best) {
+				best  = norm;
+				found = i;
+			}
+		}
+	}
+
+	if (found >= 0) {
+		pThis->latency = pThis->rxChunkStart - HIST_LEN + found - pThis->txRef;
+		pThis->state   = LATENCY_DONE;
+	} else if (pThis->rxCount - pThis->txRef > LATENCY_TIMEOUT) {
+		pThis->state   = LATENCY_FAILED;
+	}
+
+	/* keep the newest HIST_LEN frames, shorter chunks shift in */
+	if (n >= HIST_LEN) {
+		for (i = 0; i < HIST_LEN; i++) {
+			pThis->hist[i] = DOWNMIX(pS, n - HIST_LEN + i);
+		}
+	} else {
+		memmove(pThis->hist, &pThis->hist[n], (HIST_LEN - n) * sizeof(short));
+		for (i = 0; i < n; i++) {
+			pThis->hist[HIST_LEN - n + i] = DOWNMIX(pS, i);
+		}
+	}
+}
+
+/* Pass an output chunk */
+void latencyProbe_tx(latencyProbe_t *pThis, chunk_d_t *pChunk, const latencyProbe_path_t *pPath)
+{
+	int n = pChunk->bytesUsed / sizeof(unsigned int);
+	int frames = n / LATENCY_CHANNELS;
+	int i;
+
+	/* silence until the marker is back, so it is not looped through */
+	if (LATENCY_ARMED != pThis->state && LATENCY_WAITING != pThis->state) {
+		return;
+	}
+	memset(pChunk->s16_buff, 0, n * sizeof(short));
+
+	/* marker frame by frame, same on both sides, continued over chunks */
+	for (i = 0; i < frames && pThis->txPos < LATENCY_MARKER_LEN; i++, pThis->txPos++) {
+		pChunk->s16_buff[LATENCY_CHANNELS * i]     = pThis->marker[pThis->txPos];
+		pChunk->s16_buff[LATENCY_CHANNELS * i + 1] = pThis->marker[pThis->txPos];
+	}
+
+	if (LATENCY_ARMED == pThis->state) {
+		memset(pThis->hist, 0, sizeof(pThis->hist));
+
+		pThis->txRef = pThis->rxChunkStart;
+		pThis->path.fifoRx  = pPath->fifoRx  / LATENCY_CHANNELS;
+		pThis->path.rxQueue = pPath->rxQueue / LATENCY_CHANNELS;
+		pThis->path.process = pPath->process / LATENCY_CHANNELS;
+		pThis->path.txQueue = pPath->txQueue / LATENCY_CHANNELS;
+		pThis->path.fifoTx  = pPath->fifoTx  / LATENCY_CHANNELS;
+		pThis->state = LATENCY_WAITING;
+	}
+}
+
+/* Print the result */
+int latencyProbe_report(latencyProbe_t *pThis, unsigned int sampleRate)
+{
+	const latencyProbe_path_t *pP = &pThis->path;
+	unsigned int sum = pP->fifoRx + pP->rxQueue + pP->process + pP->txQueue + pP->fifoTx;
+
+	if (LATENCY_FAILED == pThis->state) {
+		printf("[LAT]: marker not detected - loopback connected?\r\n");
+		return -1;
+	}
+	if (LATENCY_DONE != pThis->state) {
+		return -1;
+	}
+
+	printf("[LAT]: round trip %u frames (%u us)\r\n", pThis->latency,
+			(unsigned int) (((unsigned long long) pThis->latency * 1000000) / sampleRate));
+	printf("[LAT]:   RX FIFO  %u\r\n", pP->fifoRx);
+	printf("[LAT]:   RX queue %u\r\n", pP->rxQueue);
+	printf("[LAT]:   process  %u\r\n", pP->process);
+	printf("[LAT]:   TX queue %u\r\n", pP->txQueue);
+	printf("[LAT]:   TX FIFO  %u\r\n", pP->fifoTx);
+	printf("[LAT]:   codec/analog %d\r\n", (int) pThis->latency - (int) sum);
+	return PASS;
+}
@@ -0,0 +1,129 @@
+/**
+ *@file latencyProbe.h
+ *
+ *@brief
+ *  - end-to-end latency measurement with an injected marker
+ *  - a 63 frame maximum length sequence replaces one TX chunk (same
+ *    marker on L and R), the output stays muted until the marker is
+ *    found again on RX by cross-correlation with the L/R downmix
+ *    (needs an analog loopback line out -> line in, one or both sides)
+ *  - the round trip is measured in L/R frames from the RX frame the
+ *    marked output chunk was made from to the marker's arrival on RX,
+ *    i.e. input-to-output latency plus the loopback delay
+ *  - at injection the audio path is snapshot for a breakdown across
+ *    FIFOs, RX queue, processing and TX queue
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#ifndef _LATENCY_PROBE_H_
+#define _LATENCY_PROBE_H_
+
+#include "chunk_d.h"
+
+/***************************************************
+            DEFINES
+***************************************************/
+
+/** marker length in frames (2^6 - 1 MLS) */
+#define LATENCY_MARKER_LEN 63
+
+/** slots per frame (interleaved L,R) */
+#define LATENCY_CHANNELS 2
+
+/** marker amplitude */
+#define LATENCY_MARKER_AMP 8000
+
+/** give up after this many RX frames without detection (1 s at 48 kHz) */
+#define LATENCY_TIMEOUT 48000
+
+/** probe states */
+#define LATENCY_IDLE    0 /* nothing to do */
+#define LATENCY_ARMED   1 /* marker starts in the next TX chunk */
+#define LATENCY_WAITING 2 /* marker (being) sent, correlating RX */
+#define LATENCY_DONE    3 /* result valid */
+#define LATENCY_FAILED  4 /* timeout */
+
+/***************************************************
+            DATA TYPES
+***************************************************/
+
+/** audio path fill at injection, in frames */
+typedef struct {
+  unsigned int fifoRx;     /* RX FIFO occupancy */
+  unsigned int rxQueue;    /* chunks waiting in the RX queue */
+  unsigned int process;    /* chunk held by the audio task */
+  unsigned int txQueue;    /* chunks waiting in the TX queue */
+  unsigned int fifoTx;     /* TX FIFO occupancy */
+} latencyProbe_path_t;
+
+/** latency probe object */
+typedef struct {
+  volatile int        state;      /* LATENCY_xxx */
+  short               marker[LATENCY_MARKER_LEN];
+  short               hist[LATENCY_MARKER_LEN - 1]; /* last RX downmix frames, across chunks */
+  unsigned int        txPos;      /* marker frames sent so far */
+  long long           markerEnergy;
+  unsigned int        rxCount;    /* RX frames seen */
+  unsigned int        rxChunkStart; /* RX frame index of the current chunk */
+  unsigned int        txRef;      /* RX frame the marked output was made from */
+  unsigned int        latency;    /* round trip in frames */
+  latencyProbe_path_t path;       /* breakdown at injection */
+} latencyProbe_t;
+
+
+/***************************************************
+            Access Methods
+***************************************************/
+
+/** Initialize the probe, generates the marker
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ */
+void latencyProbe_init(latencyProbe_t *pThis);
+
+/** Start a measurement, the marker is sent from the next TX chunk on
+ *   - chunks shorter than the marker carry it in parts
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ */
+void latencyProbe_start(latencyProbe_t *pThis);
+
+/** Feed a received chunk (every RX chunk, before processing)
+ *
+ * Parameters:
+ * @param pThis   pointer to own object
+ * @param pChunk  received chunk
+ */
+void latencyProbe_rx(latencyProbe_t *pThis, const chunk_d_t *pChunk);
+
+/** Pass an output chunk (every TX chunk, before it is queued):
+ *  inserts the marker (over several chunks if needed), mutes the rest
+ *  until the marker is detected or the measurement timed out
+ *
+ * Parameters:
+ * @param pThis   pointer to own object
+ * @param pChunk  output chunk
+ * @param pPath   path fill right now in FIFO slots (used when the marker
+ *                is inserted, kept in frames)
+ */
+void latencyProbe_tx(latencyProbe_t *pThis, chunk_d_t *pChunk, const latencyProbe_path_t *pPath);
+
+/** Print the result of the last measurement
+ *
+ * Parameters:
+ * @param pThis       pointer to own object
+ * @param sampleRate  sample rate (Hz) for the time values
+ *
+ * @return PASS/Zero if a result was available.
+ * FAIL/Negative value otherwise.
+ */
+int latencyProbe_report(latencyProbe_t *pThis, unsigned int sampleRate);
+
+#endif
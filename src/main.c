@@ -24,10 +24,13 @@
 #include "audioSample.h"
 #include "bufferPool_d.h"
 #include "zedboard_freertos.h"
+#include "appConfig.h"
+#include "sysMonitor.h"
+#include "oled.h"
+#include "gpio_interrupt.h"
+#include "gpio_ttc.h"
 
 #define VOLUME_MIN (0x2F)
-#define numChunks 561
-#define chunkSize 511
 
 /******************************************************************************
  *                     GLOBALS
@@ -39,14 +42,44 @@
     
 audioPlayer_t            audioPlayer;
 
+#if APP_STATIC_ALLOC
+/**
+ * Memory for the kernel's idle and timer service tasks.
+ * Required by FreeRTOS when configSUPPORT_STATIC_ALLOCATION is set.
+ */
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer,
+		StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize)
+{
+	static StaticTask_t idleTcb;
+	static StackType_t  idleStack[configMINIMAL_STACK_SIZE];
+
+	*ppxIdleTaskTCBBuffer   = &idleTcb;
+	*ppxIdleTaskStackBuffer = idleStack;
+	*pulIdleTaskStackSize   = configMINIMAL_STACK_SIZE;
+}
+
+void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer,
+		StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize)
+{
+	static StaticTask_t timerTcb;
+	static StackType_t  timerStack[configTIMER_TASK_STACK_DEPTH];
+
+	*ppxTimerTaskTCBBuffer   = &timerTcb;
+	*ppxTimerTaskStackBuffer = timerStack;
+	*pulTimerTaskStackSize   = configTIMER_TASK_STACK_DEPTH;
+}
+#endif
 
 int main(void)
 {
 	// Initialize the GPIO for button interrupts
 	gpio_init(&audioPlayer);
 	
+	// Initialize the OLED and draw the static screen parts
+	oled_init();
+
 	// Initialize the timer for OLED updates
-	ttc_init();
+	ttc_init(&audioPlayer);
 
 	// Initialize the audio player
     audioPlayer_init(&audioPlayer);
@@ -55,11 +88,16 @@ int main(void)
 	audioPlayer_start(&audioPlayer);
 	
 	// Start the GPIO task
-	gpio_start()
+	gpio_start();
 	
 	// Start the TTC task
 	ttc_start();
 
+#if SYSMON_ENABLED
+	// Start the CPU load / stack monitor (needs run-time stats in the BSP)
+	sysMonitor_start();
+#endif
+
 	// start the OS scheduler to kick off the tasks.
 	vTaskStartScheduler();
 	return(0);
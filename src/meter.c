@@ -0,0 +1,157 @@
+/**
+ *@file meter.c
+ *
+ *@brief
+ *  - level meter engine: ballistics and peak hold
+ *
+ * Time constants are turned into per frame steps when configured, so a
+ * frame is a dB conversion (leading zero count plus mantissa), one
+ * compare and one add per band.
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#include <string.h>
+#include "meter.h"
+#include "zedboard_freertos.h"
+
+/* top of the display range in dB Q8 */
+#define METER_TOP_Q8   (METER_RANGE_DB << 8)
+
+/* 20*log10(2) in Q8 */
+#define METER_DB_PER_OCTAVE_Q8 1541
+
+/* one-pole coefficient for time constant tauMs at frameHz, Q15
+ * (T / (tau + T), close to 1 - exp(-T/tau) without libm) */
+static int meter_coeffQ15(unsigned int tauMs, unsigned int frameHz)
+{
+	if (0 == tauMs) {
+		return 32768;
+	}
+	return (int) ((32768u * 1000u) / (tauMs * frameHz + 1000u));
+}
+
+/* dB per second to dB Q8 per frame, at least 1 */
+static int meter_stepQ8(unsigned int dbPerSec, unsigned int frameHz)
+{
+	int step = (int) ((dbPerSec << 8) / frameHz);
+
+	return (step > 0) ? step : 1;
+}
+
+/* magnitude to dB Q8 above the display floor (0..METER_TOP_Q8)
+ * log2 from the leading one plus 8 mantissa bits, ~0.5 dB worst case */
+static int meter_toDb(uint32_t mag)
+{
+	int e, log2Q8, db;
+
+	if (0 == mag) {
+		return 0;
+	}
+	e = 31 - __builtin_clz(mag);
+	log2Q8 = (e << 8) | (((mag << (31 - e)) >> 23) & 0xFF);
+
+	/* relative to METER_IN_FULL (2^16) */
+	db = ((log2Q8 - (16 << 8)) * METER_DB_PER_OCTAVE_Q8) >> 8;
+	db += METER_TOP_Q8;
+
+	if (db < 0) {
+		return 0;
+	}
+	return (db > METER_TOP_Q8) ? METER_TOP_Q8 : db;
+}
+
+/* Initialize with default ballistics */
+int meter_init(meter_t *pThis, unsigned int mode, unsigned int frameHz)
+{
+	if (NULL == pThis || 0 == frameHz || mode > METER_MODE_VU) {
+		printf("[METER]: Failed Init\r\n");
+		return -1;
+	}
+
+	memset(pThis, 0, sizeof(*pThis));
+	pThis->mode       = mode;
+	pThis->frameHz    = frameHz;
+	pThis->vuAlphaQ15 = meter_coeffQ15(METER_VU_TAU_MS, frameHz);
+	meter_setBallistics(pThis, 0, METER_DECAY_DB_S);
+	meter_setPeakHold(pThis, METER_PEAK_HOLD_MS, METER_PEAK_FALL_DB_S);
+	return PASS;
+}
+
+/* Set the PPM ballistics */
+void meter_setBallistics(meter_t *pThis, unsigned int attackMs, unsigned int decayDbS)
+{
+	pThis->attackQ15 = meter_coeffQ15(attackMs, pThis->frameHz);
+	pThis->decayStep = meter_stepQ8(decayDbS, pThis->frameHz);
+}
+
+/* Set the peak marker behaviour */
+void meter_setPeakHold(meter_t *pThis, unsigned int holdMs, unsigned int fallDbS)
+{
+	pThis->holdFrames = (holdMs * pThis->frameHz) / 1000;
+	pThis->peakStep   = meter_stepQ8(fallDbS, pThis->frameHz);
+	if (0 == holdMs) {
+		memset(pThis->peak, 0, sizeof(pThis->peak));
+	} else if (0 == pThis->holdFrames) {
+		pThis->holdFrames = 1;
+	}
+}
+
+/* Advance one display frame */
+void meter_frame(meter_t *pThis, const uint32_t *pIn)
+{
+	unsigned int i;
+
+	for (i = 0; i < METER_BAND_NUM; i++) {
+		uint32_t mag = (pIn[i] > METER_IN_FULL) ? METER_IN_FULL : pIn[i];
+		int target = meter_toDb(mag);
+		int level = pThis->level[i];
+
+		if (METER_MODE_VU == pThis->mode) {
+			/* integrate the magnitude, show its dB value */
+			pThis->vu[i] += (int) ((((int64_t) (mag << 8) - pThis->vu[i]) * pThis->vuAlphaQ15) >> 15);
+			level = meter_toDb((uint32_t) pThis->vu[i] >> 8);
+		} else if (target > level) {
+			level += ((target - level) * pThis->attackQ15 + 32767) >> 15;
+		} else {
+			level -= pThis->decayStep;
+			if (level < target) {
+				level = target;
+			}
+		}
+		pThis->level[i] = level;
+
+		/* peak marker on the raw input */
+		if (0 == pThis->holdFrames) {
+			continue;
+		}
+		if (target >= pThis->peak[i]) {
+			pThis->peak[i] = target;
+			pThis->holdLeft[i] = pThis->holdFrames;
+		} else if (pThis->holdLeft[i] > 0) {
+			pThis->holdLeft[i]--;
+		} else {
+			pThis->peak[i] -= pThis->peakStep;
+			if (pThis->peak[i] < 0) {
+				pThis->peak[i] = 0;
+			}
+		}
+	}
+}
+
+/* Scale the current state to pixel heights */
+void meter_getBars(const meter_t *pThis, uint32_t *pBars, uint32_t *pPeaks, unsigned int full)
+{
+	unsigned int i;
+
+	for (i = 0; i < METER_BAND_NUM; i++) {
+		pBars[i] = (pThis->level[i] * full + METER_TOP_Q8 / 2) / METER_TOP_Q8;
+		if (NULL != pPeaks) {
+			pPeaks[i] = (pThis->peak[i] * full + METER_TOP_Q8 / 2) / METER_TOP_Q8;
+		}
+	}
+}
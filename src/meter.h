@@ -0,0 +1,124 @@
+/**
+ *@file meter.h
+ *
+ *@brief
+ *  - level meter engine: ballistics and peak hold for the OLED bars
+ *  - input: band magnitudes once per display frame (analyzer output,
+ *    METER_IN_FULL = 0 dBFS), output: bar and peak marker heights
+ *  - levels are kept in dB (Q8) above the display floor, all per frame
+ *    work is integer and O(bands)
+ *
+ * Modes:
+ *   METER_MODE_PPM  fast attack, linear fall in dB/s (peak programme meter)
+ *   METER_MODE_VU   symmetric ~300 ms integration of the magnitude
+ *
+ * Peak markers follow the unsmoothed input, stay for the hold time and
+ * then fall at their own rate.
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#ifndef _METER_H_
+#define _METER_H_
+
+#include <stdint.h>
+
+/***************************************************
+            DEFINES
+***************************************************/
+
+/** number of bands */
+#define METER_BAND_NUM   8
+
+/** input magnitude of a full scale signal */
+#define METER_IN_FULL    65535
+
+/** displayed range below full scale */
+#define METER_RANGE_DB   48
+
+/** ballistics */
+#define METER_MODE_PPM   0
+#define METER_MODE_VU    1
+
+/** defaults */
+#define METER_DECAY_DB_S      20  /* PPM fall rate */
+#define METER_VU_TAU_MS      300  /* VU integration time */
+#define METER_PEAK_HOLD_MS  1000  /* peak marker hold */
+#define METER_PEAK_FALL_DB_S  30  /* peak marker fall after hold */
+
+/***************************************************
+            DATA TYPES
+***************************************************/
+
+/** meter object */
+typedef struct {
+  unsigned int  mode;          /* METER_MODE_xxx */
+  unsigned int  frameHz;       /* calls of meter_frame() per second */
+  int           attackQ15;     /* PPM rise per frame, share of the step (Q15) */
+  int           decayStep;     /* PPM fall per frame, dB Q8 */
+  int           vuAlphaQ15;    /* VU integration per frame (Q15) */
+  unsigned int  holdFrames;    /* peak hold, frames */
+  int           peakStep;      /* peak fall per frame, dB Q8 */
+  int           level[METER_BAND_NUM];     /* displayed level, dB Q8 above floor */
+  int           peak[METER_BAND_NUM];      /* peak marker, dB Q8 above floor */
+  unsigned int  holdLeft[METER_BAND_NUM];  /* frames until the peak falls */
+  int           vu[METER_BAND_NUM];        /* VU integrator, magnitude << 8 */
+} meter_t;
+
+/***************************************************
+            Access Methods
+***************************************************/
+
+/** Initialize the meter with default ballistics
+ *
+ * Parameters:
+ * @param pThis    pointer to own object
+ * @param mode     METER_MODE_PPM or METER_MODE_VU
+ * @param frameHz  rate meter_frame() is called at
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure.
+ */
+int meter_init(meter_t *pThis, unsigned int mode, unsigned int frameHz);
+
+/** Set the PPM ballistics
+ *
+ * Parameters:
+ * @param pThis     pointer to own object
+ * @param attackMs  rise time constant, 0 = instant
+ * @param decayDbS  fall rate in dB per second
+ */
+void meter_setBallistics(meter_t *pThis, unsigned int attackMs, unsigned int decayDbS);
+
+/** Set the peak marker behaviour
+ *
+ * Parameters:
+ * @param pThis   pointer to own object
+ * @param holdMs  time a peak stays, 0 = no markers
+ * @param fallDbS fall rate after the hold in dB per second
+ */
+void meter_setPeakHold(meter_t *pThis, unsigned int holdMs, unsigned int fallDbS);
+
+/** Advance one display frame
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ * @param pIn    METER_BAND_NUM magnitudes (0..METER_IN_FULL)
+ */
+void meter_frame(meter_t *pThis, const uint32_t *pIn);
+
+/** Scale the current state to pixel heights
+ *
+ * Parameters:
+ * @param pThis   pointer to own object
+ * @param pBars   METER_BAND_NUM bar heights (0..full)
+ * @param pPeaks  METER_BAND_NUM peak marker heights (0 = none), may be NULL
+ * @param full    height of a full scale bar
+ */
+void meter_getBars(const meter_t *pThis, uint32_t *pBars, uint32_t *pPeaks, unsigned int full);
+
+#endif
@@ -0,0 +1,237 @@
+/**
+ *@file mixer.c
+ *
+ *@brief
+ *  - N input mixer stage with Q15 gains and saturating output
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#include <string.h>
+#include "mixer.h"
+#include "zedboard_freertos.h"
+
+#ifdef __ARM_NEON__
+#include <arm_neon.h>
+#endif
+
+#define malloc(size) pvPortMalloc(size)
+
+/* Initialize mixer */
+int mixer_init(mixer_t *pThis, bufferPool_d_t *pBuffP, int *pAcc, unsigned int maxSamples)
+{
+	unsigned int input;
+
+	if (NULL == pThis || NULL == pBuffP) {
+		printf("[MIX]: Failed Init\r\n");
+		return -1;
+	}
+
+	pThis->pBuffP     = pBuffP;
+	pThis->activeMask = 0;
+	pThis->maxSamples = maxSamples;
+	pThis->pAcc       = (NULL != pAcc) ? pAcc : malloc(maxSamples * sizeof(int));
+	if (NULL == pThis->pAcc) {
+		printf("[MIX]: Failed to allocate accumulator\r\n");
+		return -1;
+	}
+
+	for (input = 0; input < MIXER_MAX_INPUTS; input++) {
+		mixer_input_t *pIn = &pThis->inputs[input];
+
+		pIn->pCur   = NULL;
+		pIn->offset = 0;
+		pIn->gain   = MIXER_GAIN_UNITY;
+		pIn->queue  = APP_QUEUE_CREATE(pIn, queue, MIXER_INPUT_DEPTH, sizeof(chunk_d_t*));
+		if (0 == pIn->queue) {
+			printf("[MIX]: Failed to create input queue %d\r\n", input);
+			return -1;
+		}
+	}
+
+	return PASS;
+}
+
+/* Set the gain of an input */
+void mixer_setGain(mixer_t *pThis, unsigned int input, short gain)
+{
+	if (input < MIXER_MAX_INPUTS) {
+		pThis->inputs[input].gain = gain;
+	}
+}
+
+/* Submit a filled chunk to an input */
+int mixer_submit(mixer_t *pThis, unsigned int input, chunk_d_t *pChunk)
+{
+	if (input >= MIXER_MAX_INPUTS || NULL == pChunk) {
+		return -1;
+	}
+
+	if (pdTRUE != xQueueSend(pThis->inputs[input].queue, &pChunk, 0)) {
+		/* producer is ahead of the mixer, drop the chunk */
+		bufferPool_d_release(pThis->pBuffP, pChunk);
+		return -1;
+	}
+
+	taskENTER_CRITICAL();
+	pThis->activeMask |= (1u << input);
+	taskEXIT_CRITICAL();
+	return 1;
+}
+
+/* Number of queued chunks */
+unsigned int mixer_queued(mixer_t *pThis, unsigned int input)
+{
+	if (input >= MIXER_MAX_INPUTS) {
+		return 0;
+	}
+	return uxQueueMessagesWaiting(pThis->inputs[input].queue);
+}
+
+/* Drop everything queued */
+void mixer_flush(mixer_t *pThis)
+{
+	chunk_d_t *pChunk = NULL;
+	unsigned int input;
+
+	for (input = 0; input < MIXER_MAX_INPUTS; input++) {
+		mixer_input_t *pIn = &pThis->inputs[input];
+
+		if (NULL != pIn->pCur) {
+			bufferPool_d_release(pThis->pBuffP, pIn->pCur);
+			pIn->pCur   = NULL;
+			pIn->offset = 0;
+		}
+		while (pdTRUE == xQueueReceive(pIn->queue, &pChunk, 0)) {
+			bufferPool_d_release(pThis->pBuffP, pChunk);
+		}
+	}
+
+	taskENTER_CRITICAL();
+	pThis->activeMask = 0;
+	taskEXIT_CRITICAL();
+}
+
+/** Accumulate n gain scaled samples into pAcc
+ *
+ *@param pAcc  accumulator
+ *@param pIn   16 bit samples
+ *@param n     number of samples
+ *@param gain  Q15 gain
+ */
+static void mixer_accumulate(int *pAcc, const short *pIn, unsigned int n, short gain)
+{
+	unsigned int i = 0;
+
+#ifdef __ARM_NEON__
+	/* 8 samples per iteration: rounding Q15 multiply, widening add */
+	for (; i + 8 <= n; i += 8) {
+		int16x8_t x  = vqrdmulhq_n_s16(vld1q_s16(&pIn[i]), gain);
+		int32x4_t lo = vld1q_s32(&pAcc[i]);
+		int32x4_t hi = vld1q_s32(&pAcc[i + 4]);
+
+		vst1q_s32(&pAcc[i],     vaddw_s16(lo, vget_low_s16(x)));
+		vst1q_s32(&pAcc[i + 4], vaddw_s16(hi, vget_high_s16(x)));
+	}
+#endif
+
+	for (; i < n; i++) {
+		pAcc[i] += (pIn[i] * gain + 0x4000) >> 15;
+	}
+}
+
+/** Saturate the accumulator into 16 bit samples
+ *
+ *@param pOut  destination
+ *@param pAcc  accumulator
+ *@param n     number of samples
+ */
+static void mixer_saturate(short *pOut, const int *pAcc, unsigned int n)
+{
+	unsigned int i = 0;
+
+#ifdef __ARM_NEON__
+	for (; i + 8 <= n; i += 8) {
+		int16x4_t lo = vqmovn_s32(vld1q_s32(&pAcc[i]));
+		int16x4_t hi = vqmovn_s32(vld1q_s32(&pAcc[i + 4]));
+		vst1q_s16(&pOut[i], vcombine_s16(lo, hi));
+	}
+#endif
+
+	for (; i < n; i++) {
+		int s = pAcc[i];
+		if (s > 32767)  s = 32767;
+		if (s < -32768) s = -32768;
+		pOut[i] = (short) s;
+	}
+}
+
+/* Mix all active inputs into an output chunk */
+int mixer_process(mixer_t *pThis, chunk_d_t *pOut, unsigned int samples)
+{
+	unsigned int mask;
+
+	if (samples > pThis->maxSamples) {
+		samples = pThis->maxSamples;
+	}
+	if (samples > pOut->bytesMax / sizeof(unsigned int)) {
+		samples = pOut->bytesMax / sizeof(unsigned int);
+	}
+
+	memset(pThis->pAcc, 0, samples * sizeof(int));
+
+	/* visit active inputs only */
+	mask = pThis->activeMask;
+	while (mask) {
+		unsigned int input = __builtin_ctz(mask);
+		mixer_input_t *pIn = &pThis->inputs[input];
+		unsigned int done = 0;
+
+		mask &= mask - 1;
+
+		while (done < samples) {
+			unsigned int avail, n;
+
+			if (NULL == pIn->pCur) {
+				if (pdTRUE != xQueueReceive(pIn->queue, &pIn->pCur, 0)) {
+					/* underrun: rest of this input is silence */
+					pIn->pCur = NULL;
+					break;
+				}
+				pIn->offset = 0;
+			}
+
+			avail = pIn->pCur->bytesUsed / sizeof(unsigned int) - pIn->offset;
+			n = (avail < samples - done) ? avail : samples - done;
+
+			if (0 != pIn->gain) {
+				mixer_accumulate(&pThis->pAcc[done], &pIn->pCur->s16_buff[pIn->offset], n, pIn->gain);
+			}
+			done        += n;
+			pIn->offset += n;
+
+			/* chunk exhausted, give it back */
+			if (pIn->offset * sizeof(unsigned int) >= (unsigned int) pIn->pCur->bytesUsed) {
+				bufferPool_d_release(pThis->pBuffP, pIn->pCur);
+				pIn->pCur = NULL;
+			}
+		}
+
+		/* input ran dry - stop visiting it until the next submit */
+		if (NULL == pIn->pCur) {
+			taskENTER_CRITICAL();
+			if (0 == uxQueueMessagesWaiting(pIn->queue)) {
+				pThis->activeMask &= ~(1u << input);
+			}
+			taskEXIT_CRITICAL();
+		}
+	}
+
+	mixer_saturate(pOut->s16_buff, pThis->pAcc, samples);
+	pOut->bytesUsed = samples * sizeof(unsigned int);
+	return samples;
+}
@@ -0,0 +1,147 @@
+/**
+ *@file mixer.h
+ *
+ *@brief
+ *  - N input mixer stage (live input, clip player, file stream ...)
+ *
+ * Every input owns a small queue of chunks that its producer fills
+ * asynchronously. mixer_process() builds one output chunk from all inputs
+ * that have data queued; inputs without data are silence and cost nothing,
+ * as only inputs flagged in activeMask are visited. Chunks of different
+ * lengths are consumed across output chunks (partially used chunks are
+ * kept until exhausted).
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#ifndef _MIXER_H_
+#define _MIXER_H_
+
+#include "bufferPool_d.h"
+
+/***************************************************
+            DEFINES
+***************************************************/
+
+/**
+ * @def MIXER_MAX_INPUTS
+ * @brief number of mixer inputs (bits in activeMask)
+ */
+#define MIXER_MAX_INPUTS 8
+
+/**
+ * @def MIXER_INPUT_DEPTH
+ * @brief chunks that can be queued per input
+ */
+#define MIXER_INPUT_DEPTH 4
+
+/**
+ * @def MIXER_GAIN_UNITY
+ * @brief gains are Q15 (0 = mute, MIXER_GAIN_UNITY = 0 dB)
+ */
+#define MIXER_GAIN_UNITY 0x7FFF
+
+/** input assignment used by the audio player */
+#define MIXER_IN_LIVE 0 /* RX chunks from the codec */
+#define MIXER_IN_CLIP 1 /* sample bank playback */
+#define MIXER_IN_FILE 2 /* streamed file */
+
+/***************************************************
+            DATA TYPES
+***************************************************/
+
+/** mixer input
+ */
+typedef struct {
+  QueueHandle_t  queue;   /* chunks submitted by the producer */
+  chunk_d_t     *pCur;    /* chunk currently being consumed */
+  unsigned int   offset;  /* next sample in pCur */
+  short          gain;    /* Q15 gain */
+  APP_QUEUE_STORAGE(queue, MIXER_INPUT_DEPTH, sizeof(chunk_d_t*))
+} mixer_input_t;
+
+/** mixer object
+ */
+typedef struct {
+  mixer_input_t          inputs[MIXER_MAX_INPUTS];
+  volatile unsigned int  activeMask;  /* inputs with data queued or in pCur */
+  int                   *pAcc;        /* accumulator, one word per sample */
+  unsigned int           maxSamples;  /* size of pAcc */
+  bufferPool_d_t        *pBuffP;      /* pool consumed chunks return to */
+} mixer_t;
+
+
+/***************************************************
+            Access Methods
+***************************************************/
+
+/** Initialize mixer
+ *
+ * Parameters:
+ * @param pThis       pointer to own object
+ * @param pBuffP      buffer pool input chunks are released to
+ * @param pAcc        accumulator of maxSamples words, NULL to allocate
+ * @param maxSamples  largest output chunk in samples
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure.
+ */
+int mixer_init(mixer_t *pThis, bufferPool_d_t *pBuffP, int *pAcc, unsigned int maxSamples);
+
+/** Set the gain of an input
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ * @param input  input number
+ * @param gain   Q15 gain (MIXER_GAIN_UNITY = 0 dB)
+ */
+void mixer_setGain(mixer_t *pThis, unsigned int input, short gain);
+
+/** Submit a filled chunk to an input
+ *   - ownership passes to the mixer, the chunk is released to the pool
+ *     once mixed (or immediately if the input queue is full)
+ *
+ * Parameters:
+ * @param pThis   pointer to own object
+ * @param input   input number
+ * @param pChunk  chunk to mix
+ *
+ * @return 1 on success, negative value if the chunk was dropped
+ */
+int mixer_submit(mixer_t *pThis, unsigned int input, chunk_d_t *pChunk);
+
+/** Number of chunks waiting on an input (not counting a partly used one)
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ * @param input  input number
+ *
+ * @return queued chunks
+ */
+unsigned int mixer_queued(mixer_t *pThis, unsigned int input);
+
+/** Drop everything queued on all inputs, chunks go back to the pool
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ */
+void mixer_flush(mixer_t *pThis);
+
+/** Mix all active inputs into an output chunk
+ *   - missing input data is treated as silence
+ *   - output is saturated to 16 bit
+ *
+ * Parameters:
+ * @param pThis    pointer to own object
+ * @param pOut     output chunk
+ * @param samples  number of samples to produce
+ *
+ * @return number of samples produced
+ */
+int mixer_process(mixer_t *pThis, chunk_d_t *pOut, unsigned int samples);
+
+#endif
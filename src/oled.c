@@ -1,46 +1,381 @@
-
+/**
+ *@file oled.c
+ *
+ *@brief
+ *  - 128x64 OLED (SSD1306) level meter display
+ *
+ * All drawing goes to oled_fb. Bars, peak markers and numbers are copied
+ * from the generated atlas (oled_atlas.c) page byte by page byte. A write
+ * only touches the dirty range of a page if the byte really changes, so
+ * redrawing an unchanged bar costs a compare and nothing on the bus.
+ * oled_flush() sets the controller window (horizontal addressing) to the
+ * bounding rectangle of the dirty ranges and sends the rectangle in one
+ * polled transfer; the PS SPI has no DMA request line, the transfer is a
+ * FIFO fill loop in XSpiPs.
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#include <string.h>
 #include "oled.h"
+#include "oled_atlas.h"
+
+#ifdef OLED_POSIX
+#include <stdio.h>
+#else
+#include "zedboard_freertos.h"
+#include "xspips.h"
+#include "sleep.h"
+#include "gpio_interrupt.h"
+#endif
+
+/* pixel data of the display, [page][column], bit 0 = top row of the page */
+static uint8_t oled_fb[OLED_PAGES][OLED_SCRN_WIDTH];
+
+/* dirty column range per page, clean when lo > hi */
+static uint8_t oled_dirtyLo[OLED_PAGES];
+static uint8_t oled_dirtyHi[OLED_PAGES];
+
+/* bar height and peak marker currently drawn per band */
+static uint8_t oled_barLevel[OLED_BAND_NUM];
+static uint8_t oled_barPeak[OLED_BAND_NUM];
+
+/* length of the load line currently drawn */
+static unsigned int oled_loadColumns;
+
+/* first column of band i */
+#define OLED_BAND_COL(i) (2 + (i) * (OLED_BAND_WIDTH + OLED_BAND_GAP))
+
+/* rows 'first' .. 'first + n - 1' as a column mask */
+#define OLED_ROWS(first, n) ((((uint64_t) 1 << (n)) - 1) << (first))
+
+/* SSD1306 commands */
+#define SSD1306_SET_COL_ADDR   0x21
+#define SSD1306_SET_PAGE_ADDR  0x22
+#define SSD1306_DISPLAY_ON     0xAF
+#define SSD1306_DISPLAY_OFF    0xAE
+
+/* bytes of a full screen, largest flush */
+#define OLED_FB_BYTES (OLED_PAGES * OLED_SCRN_WIDTH)
+
+static void oled_markDirty(unsigned int page, unsigned int col)
+{
+	if (col < oled_dirtyLo[page]) {
+		oled_dirtyLo[page] = col;
+	}
+	if (col > oled_dirtyHi[page]) {
+		oled_dirtyHi[page] = col;
+	}
+}
+
+static void oled_markClean(void)
+{
+	memset(oled_dirtyLo, 0xFF, sizeof(oled_dirtyLo));
+	memset(oled_dirtyHi, 0, sizeof(oled_dirtyHi));
+}
+
+#ifdef OLED_POSIX
+/***************************************************
+            Host backend: PGM image
+***************************************************/
+
+static int oled_hwInit(void)
+{
+	return 0;
+}
+
+/* the whole screen is written, rectangle only decides whether to */
+static void oled_hwWrite(unsigned int colLo, unsigned int colHi, unsigned int pageLo, unsigned int pageHi,
+		const uint8_t *pData, unsigned int bytes)
+{
+	FILE *pFile = fopen("oled.pgm", "wb");
+	unsigned int r, c;
+
+	if (NULL == pFile) {
+		printf("[OLED]: can not write oled.pgm\r\n");
+		return;
+	}
+
+	fprintf(pFile, "P5\n%d %d\n255\n", OLED_SCRN_WIDTH, OLED_SCRN_HEIGHT);
+	for (r = 0; r < OLED_SCRN_HEIGHT; r++) {
+		for (c = 0; c < OLED_SCRN_WIDTH; c++) {
+			fputc((oled_fb[r / 8][c] >> (r % 8)) & 1 ? 255 : 0, pFile);
+		}
+	}
+	fclose(pFile);
+}
+
+#else
+/***************************************************
+            Target backend: PS SPI + EMIO pins
+***************************************************/
 
-void oled_init(){
-	string line;
-	uint8_t num_bitmaps[8][5];
-	
-	// write 1111-11 to first and last column
-	
-	for(int i = 1; i < OLED_SCRN_WIDTH-1){
-		// write 100--001 to each column
-	}
-	
-	
-	for(int i = 0; i < OLED_BAND_NUM; i++){
-		for(int j = 0; j < OLED_NUM_WIDTH; j++){
-			// write num_bitmaps[i][j] to OLED 
-		}
-	}
-}
-
-// 52 pixels available - need to map percentage to this
-void oled_updateDisplay(uint_32t * levelData){
-	
-	uint32_t writeData = 1;
-	
-	// For each band that we wish to display
-	for(int i = 0; i < OLED_BAND_NUM; i++){
-		
-		for(int j = 0; j < levelData[i]){
-			writeData |= 1;
-			writeData << 1;
-		}
-		
-		writeData << OLED_NUM_HEIGHT + 2;
-		
-		// For each column within the band
-		
-		for(int j = 0; j < OLED_BAND_WIDTH){
-			// write the level to each column in the band
-			column &= CLEAR_BITMASK;
-			column |= writeData;
-			
-		}
-	}
-}
\ No newline at end of file
+/* masked write to GPIO bank 2 bits 0..15: upper half = keep mask */
+#define OLED_GPIO_MASK_DATA_2_LSW (GPIO_BASE + 0x10)
+#define OLED_PINS (OLED_PIN_DC | OLED_PIN_RES | OLED_PIN_VBAT | OLED_PIN_VDD)
+
+static XSpiPs oled_spi;
+
+/* set the control pins in 'pins' to 'value' without touching the others */
+static void oled_pinWrite(uint32_t pins, uint32_t value)
+{
+	*(volatile uint32_t *) OLED_GPIO_MASK_DATA_2_LSW = ((~pins & 0xFFFF) << 16) | (value & pins);
+}
+
+static void oled_command(const uint8_t *pCmd, unsigned int n)
+{
+	oled_pinWrite(OLED_PIN_DC, 0);
+	XSpiPs_PolledTransfer(&oled_spi, (u8 *) pCmd, NULL, n);
+}
+
+static int oled_hwInit(void)
+{
+	/* charge pump on, horizontal addressing, column/row remap, contrast */
+	static const uint8_t initCmds[] = {
+		SSD1306_DISPLAY_OFF,
+		0x8D, 0x14,
+		0xD9, 0xF1,
+		0x20, 0x00,
+		0xA1, 0xC8,
+		0xDA, 0x20,
+		0x81, 0x8F,
+	};
+	static const uint8_t onCmd = SSD1306_DISPLAY_ON;
+	XSpiPs_Config *pConfig;
+
+	pConfig = XSpiPs_LookupConfig(XPAR_PS7_SPI_0_DEVICE_ID);
+	if (NULL == pConfig || XST_SUCCESS != XSpiPs_CfgInitialize(&oled_spi, pConfig, pConfig->BaseAddress)) {
+		printf("[OLED]: SPI init failed\r\n");
+		return -1;
+	}
+	XSpiPs_SetOptions(&oled_spi, XSPIPS_MASTER_OPTION | XSPIPS_FORCE_SSELECT_OPTION);
+	XSpiPs_SetClkPrescaler(&oled_spi, XSPIPS_CLK_PRESCALE_16);
+	XSpiPs_SetSlaveSelect(&oled_spi, 0);
+
+	/* control pins are outputs */
+	*(volatile uint32_t *) GPIO_DIRM_2 |= OLED_PINS;
+	*(volatile uint32_t *) GPIO_OEN_2  |= OLED_PINS;
+
+	/* power up: logic supply, reset pulse, panel commands, panel supply */
+	oled_pinWrite(OLED_PINS, OLED_PIN_RES | OLED_PIN_VBAT | OLED_PIN_VDD);
+	oled_pinWrite(OLED_PIN_VDD, 0);
+	usleep(1000);
+	oled_pinWrite(OLED_PIN_RES, 0);
+	usleep(1000);
+	oled_pinWrite(OLED_PIN_RES, OLED_PIN_RES);
+	oled_command(initCmds, sizeof(initCmds));
+	oled_pinWrite(OLED_PIN_VBAT, 0);
+	usleep(100000);
+	oled_command(&onCmd, 1);
+
+	return 0;
+}
+
+static void oled_hwWrite(unsigned int colLo, unsigned int colHi, unsigned int pageLo, unsigned int pageHi,
+		const uint8_t *pData, unsigned int bytes)
+{
+	uint8_t window[6];
+
+	window[0] = SSD1306_SET_COL_ADDR;
+	window[1] = colLo;
+	window[2] = colHi;
+	window[3] = SSD1306_SET_PAGE_ADDR;
+	window[4] = pageLo;
+	window[5] = pageHi;
+	oled_command(window, sizeof(window));
+
+	oled_pinWrite(OLED_PIN_DC, OLED_PIN_DC);
+	XSpiPs_PolledTransfer(&oled_spi, (u8 *) pData, NULL, bytes);
+}
+#endif
+
+/***************************************************
+            Framebuffer
+***************************************************/
+
+/* Write a run of column bytes into one page */
+void oled_writeColumns(unsigned int page, unsigned int col, const uint8_t *pData, unsigned int n)
+{
+	uint8_t *pFb = &oled_fb[page][col];
+	unsigned int i;
+
+	for (i = 0; i < n; i++) {
+		if (pFb[i] != pData[i]) {
+			pFb[i] = pData[i];
+			oled_markDirty(page, col + i);
+		}
+	}
+}
+
+/* Write one full-height column */
+void oled_writeColumn(unsigned int col, uint64_t mask, uint64_t bits)
+{
+	unsigned int page;
+
+	for (page = 0; page < OLED_PAGES; page++) {
+		uint8_t m = (uint8_t) (mask >> (8 * page));
+		uint8_t v;
+
+		if (0 == m) {
+			continue;
+		}
+		v = (oled_fb[page][col] & ~m) | ((uint8_t) (bits >> (8 * page)) & m);
+		oled_writeColumns(page, col, &v, 1);
+	}
+}
+
+/* Set the 'mask' rows of n columns in one page to 'value' */
+static void oled_fillColumns(unsigned int page, unsigned int col, uint8_t mask, uint8_t value, unsigned int n)
+{
+	uint8_t row[OLED_SCRN_WIDTH];
+	unsigned int i;
+
+	if (0xFF == mask) {
+		memset(row, value, n);
+	} else {
+		for (i = 0; i < n; i++) {
+			row[i] = (oled_fb[page][col + i] & ~mask) | (value & mask);
+		}
+	}
+	oled_writeColumns(page, col, row, n);
+}
+
+/* Send the changed part of the framebuffer */
+unsigned int oled_flush(void)
+{
+	static uint8_t txBuff[OLED_FB_BYTES];
+	unsigned int colLo = OLED_SCRN_WIDTH, colHi = 0;
+	unsigned int pageLo = OLED_PAGES, pageHi = 0;
+	unsigned int page, width, bytes = 0;
+
+	for (page = 0; page < OLED_PAGES; page++) {
+		if (oled_dirtyLo[page] > oled_dirtyHi[page]) {
+			continue;
+		}
+		if (page < pageLo) {
+			pageLo = page;
+		}
+		pageHi = page;
+		if (oled_dirtyLo[page] < colLo) {
+			colLo = oled_dirtyLo[page];
+		}
+		if (oled_dirtyHi[page] > colHi) {
+			colHi = oled_dirtyHi[page];
+		}
+	}
+
+	if (pageLo > pageHi) {
+		return 0;
+	}
+
+	/* rectangle in controller order: page by page, columns left to right */
+	width = colHi - colLo + 1;
+	for (page = pageLo; page <= pageHi; page++) {
+		memcpy(&txBuff[bytes], &oled_fb[page][colLo], width);
+		bytes += width;
+	}
+
+	oled_hwWrite(colLo, colHi, pageLo, pageHi, txBuff, bytes);
+	oled_markClean();
+	return bytes;
+}
+
+/***************************************************
+            Meter drawing
+***************************************************/
+
+/* Initialize display, draw border and band numbers */
+int oled_init(void)
+{
+	unsigned int col, i, p;
+
+	if (0 != oled_hwInit()) {
+		return -1;
+	}
+
+	/* controller RAM content is unknown: send every byte on first flush */
+	memset(oled_fb, 0, sizeof(oled_fb));
+	memset(oled_barLevel, 0, sizeof(oled_barLevel));
+	memset(oled_barPeak, 0, sizeof(oled_barPeak));
+	oled_loadColumns = 0;
+	for (i = 0; i < OLED_PAGES; i++) {
+		oled_dirtyLo[i] = 0;
+		oled_dirtyHi[i] = OLED_SCRN_WIDTH - 1;
+	}
+
+	/* band numbers (whole page bytes, before the frame) */
+	for (i = 0; i < OLED_BAND_NUM; i++) {
+		for (p = 0; p < OLED_NUM_PAGES; p++) {
+			oled_writeColumns(OLED_NUM_PAGE0 + p, OLED_BAND_COL(i), oled_atlasNum[i][p], OLED_BAND_WIDTH);
+		}
+	}
+
+	/* frame: first and last column full, bottom row */
+	oled_writeColumn(0, ~(uint64_t) 0, ~(uint64_t) 0);
+	oled_writeColumn(OLED_SCRN_WIDTH - 1, ~(uint64_t) 0, ~(uint64_t) 0);
+	for (col = 1; col < OLED_SCRN_WIDTH - 1; col++) {
+		oled_writeColumn(col, OLED_ROWS(OLED_SCRN_HEIGHT - 1, 1), ~(uint64_t) 0);
+	}
+
+	oled_flush();
+	return 0;
+}
+
+/* Clear the bar area of all bands */
+void oled_clearBands(void)
+{
+	static const uint32_t zero[OLED_BAND_NUM];
+
+	oled_updateDisplay(zero, zero);
+}
+
+/* Draw the level bars and peak markers, only pages whose byte changes are touched */
+void oled_updateDisplay(const uint32_t *levelData, const uint32_t *peakData)
+{
+	unsigned int i, p;
+
+	for (i = 0; i < OLED_BAND_NUM; i++) {
+		unsigned int level = (levelData[i] > OLED_BAR_MAX) ? OLED_BAR_MAX : levelData[i];
+		unsigned int peak = 0;
+
+		if (NULL != peakData) {
+			peak = (peakData[i] > OLED_BAR_MAX) ? OLED_BAR_MAX : peakData[i];
+		}
+		if (level == oled_barLevel[i] && peak == oled_barPeak[i]) {
+			continue;
+		}
+
+		for (p = 0; p < OLED_PAGES; p++) {
+			uint8_t oldByte = oled_atlasBar[oled_barLevel[i]][p] | oled_atlasPeak[oled_barPeak[i]][p];
+			uint8_t newByte = oled_atlasBar[level][p] | oled_atlasPeak[peak][p];
+
+			if (oldByte != newByte) {
+				oled_fillColumns(p, OLED_BAND_COL(i), oled_atlasBarMask[p], newByte, OLED_BAND_WIDTH);
+			}
+		}
+		oled_barLevel[i] = level;
+		oled_barPeak[i]  = peak;
+	}
+}
+
+/* CPU load (1/1000) shown as the length of the top border */
+void oled_updateLoad(uint32_t cpuPermille)
+{
+	unsigned int columns = (cpuPermille * (OLED_SCRN_WIDTH - 2)) / 1000;
+
+	if (columns > OLED_SCRN_WIDTH - 2) {
+		columns = OLED_SCRN_WIDTH - 2;
+	}
+	if (columns == oled_loadColumns) {
+		return;
+	}
+
+	/* row 0 of columns 1..columns on, the rest off */
+	oled_fillColumns(0, 1, 0x01, 0x01, columns);
+	oled_fillColumns(0, 1 + columns, 0x01, 0x00, OLED_SCRN_WIDTH - 2 - columns);
+	oled_loadColumns = columns;
+}
@@ -1,30 +1,116 @@
-#if undef __OLED_H__
+/**
+ *@file oled.h
+ *
+ *@brief
+ *  - 128x64 OLED (SSD1306) level meter display
+ *  - drawing goes to a 1-bpp framebuffer in RAM (8 pages of 128 column
+ *    bytes, bit 0 = top row of the page); each page remembers its dirty
+ *    column range
+ *  - oled_flush() sends the bounding rectangle of everything that changed
+ *    as one bulk SPI transfer, so the cost follows the amount of change
+ *  - built with OLED_POSIX the flush writes oled.pgm instead (host
+ *    rendering tests)
+ *
+ * Screen layout (rows top down):
+ *   0        border, length shows the CPU load
+ *   1..52    level bars, OLED_BAND_NUM bands of OLED_BAND_WIDTH columns
+ *   53       gap
+ *   54..62   band numbers
+ *   63       border
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#ifndef __OLED_H__
 #define __OLED_H__
 
-#include<iostream>
-#include<fstream>
+#include <stdint.h>
 
+/***************************************************
+            DEFINES
+***************************************************/
 
-#define OLED_BAND_NUM       8 // update this 
-#define OLED_BAND_WIDTH    14 // update this too
+#define OLED_BAND_NUM       8
+#define OLED_BAND_WIDTH    14
+#define OLED_BAND_GAP       1
 
 #define OLED_SCRN_WIDTH   128
 #define OLED_SCRN_HEIGHT   64
+#define OLED_PAGES        (OLED_SCRN_HEIGHT / 8)
 
 #define OLED_NUM_WIDTH	  	5
 #define OLED_NUM_HEIGHT 	9
 
-uint8_t numBitmaps[8][5] = [[010000010, 010000010, 011111110, 000000010, 000000010], 
-							[010011110, 010010010, 010010010, 010010010, 011110010],
-							[010000010, 010000010, 010010010, 010010010, 011111110],
-							[011110000, 000010000, 000010000, 011111110, 000010000],
-							[011110010, 010010010, 010010010, 010010010, 010011110],
-							[011111110, 010010010, 010010010, 010010010, 010011110],
-							[010000000, 010000000, 010000000, 010000000, 011111110],
-							[011111110, 010010010, 010010010, 010010010, 011111110]]
+/** bar area: rows OLED_BAR_TOP .. OLED_BAR_TOP + OLED_BAR_MAX - 1 */
+#define OLED_BAR_TOP        1
+#define OLED_BAR_MAX       52
 
-void oled_init();
-void oled_clearBands();
-void oled_updateDisplay(uint_32t * levelData);
+/** first row of the band numbers */
+#define OLED_NUM_TOP       54
 
-#endif
\ No newline at end of file
+/** EMIO (GPIO bank 2) bits of the OLED control lines, as wired in the
+ *  hardware design */
+#define OLED_PIN_DC    (1 << 8)   /* 0 = command, 1 = data */
+#define OLED_PIN_RES   (1 << 9)   /* reset, active low */
+#define OLED_PIN_VBAT  (1 << 10)  /* panel supply, active low */
+#define OLED_PIN_VDD   (1 << 11)  /* logic supply, active low */
+
+/***************************************************
+            Access Methods
+***************************************************/
+
+/** Initialize the display and draw the static parts (border, numbers)
+ *
+ * @return 0 success, non-zero otherwise
+ */
+int oled_init(void);
+
+/** Clear the bar area of all bands */
+void oled_clearBands(void);
+
+/** Draw the level bars and peak markers
+ *
+ * Parameters:
+ * @param levelData  OLED_BAND_NUM bar heights in pixels (0..OLED_BAR_MAX)
+ * @param peakData   OLED_BAND_NUM peak marker heights (0 = none), may be NULL
+ */
+void oled_updateDisplay(const uint32_t *levelData, const uint32_t *peakData);
+
+/** Show the CPU load as the length of the top border
+ *
+ * Parameters:
+ * @param cpuPermille  load in 1/1000
+ */
+void oled_updateLoad(uint32_t cpuPermille);
+
+/** Write a run of column bytes into one page of the framebuffer,
+ *  marks only bytes that actually change as dirty
+ *
+ * Parameters:
+ * @param page  page (0..OLED_PAGES-1)
+ * @param col   first column
+ * @param pData column bytes
+ * @param n     number of columns
+ */
+void oled_writeColumns(unsigned int page, unsigned int col, const uint8_t *pData, unsigned int n);
+
+/** Write one full-height column (bit r = row r) into the framebuffer
+ *
+ * Parameters:
+ * @param col   column
+ * @param mask  rows to write
+ * @param bits  pixel values for the rows in mask
+ */
+void oled_writeColumn(unsigned int col, uint64_t mask, uint64_t bits);
+
+/** Send the changed part of the framebuffer to the display
+ *
+ * @return bytes of pixel data sent
+ */
+unsigned int oled_flush(void);
+
+#endif
@@ -0,0 +1,157 @@
+/**
+ *@file oled_atlas.c
+ *
+ *@brief
+ *  - OLED meter atlas, generated by tools/oledatlas.c - do not edit
+ *
+ *******************************************************************************/
+#include "oled_atlas.h"
+
+const uint8_t oled_atlasBarMask[OLED_PAGES] = { 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0x1f, 0x00 };
+
+const uint8_t oled_atlasBar[OLED_BAR_MAX + 1][OLED_PAGES] = {
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  /*  0 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00 },  /*  1 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x00 },  /*  2 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1c, 0x00 },  /*  3 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1e, 0x00 },  /*  4 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x00 },  /*  5 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x1f, 0x00 },  /*  6 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0x1f, 0x00 },  /*  7 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x1f, 0x00 },  /*  8 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0x1f, 0x00 },  /*  9 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0xf8, 0x1f, 0x00 },  /* 10 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0xfc, 0x1f, 0x00 },  /* 11 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0xfe, 0x1f, 0x00 },  /* 12 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x1f, 0x00 },  /* 13 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x80, 0xff, 0x1f, 0x00 },  /* 14 */
+	{ 0x00, 0x00, 0x00, 0x00, 0xc0, 0xff, 0x1f, 0x00 },  /* 15 */
+	{ 0x00, 0x00, 0x00, 0x00, 0xe0, 0xff, 0x1f, 0x00 },  /* 16 */
+	{ 0x00, 0x00, 0x00, 0x00, 0xf0, 0xff, 0x1f, 0x00 },  /* 17 */
+	{ 0x00, 0x00, 0x00, 0x00, 0xf8, 0xff, 0x1f, 0x00 },  /* 18 */
+	{ 0x00, 0x00, 0x00, 0x00, 0xfc, 0xff, 0x1f, 0x00 },  /* 19 */
+	{ 0x00, 0x00, 0x00, 0x00, 0xfe, 0xff, 0x1f, 0x00 },  /* 20 */
+	{ 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0x1f, 0x00 },  /* 21 */
+	{ 0x00, 0x00, 0x00, 0x80, 0xff, 0xff, 0x1f, 0x00 },  /* 22 */
+	{ 0x00, 0x00, 0x00, 0xc0, 0xff, 0xff, 0x1f, 0x00 },  /* 23 */
+	{ 0x00, 0x00, 0x00, 0xe0, 0xff, 0xff, 0x1f, 0x00 },  /* 24 */
+	{ 0x00, 0x00, 0x00, 0xf0, 0xff, 0xff, 0x1f, 0x00 },  /* 25 */
+	{ 0x00, 0x00, 0x00, 0xf8, 0xff, 0xff, 0x1f, 0x00 },  /* 26 */
+	{ 0x00, 0x00, 0x00, 0xfc, 0xff, 0xff, 0x1f, 0x00 },  /* 27 */
+	{ 0x00, 0x00, 0x00, 0xfe, 0xff, 0xff, 0x1f, 0x00 },  /* 28 */
+	{ 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x1f, 0x00 },  /* 29 */
+	{ 0x00, 0x00, 0x80, 0xff, 0xff, 0xff, 0x1f, 0x00 },  /* 30 */
+	{ 0x00, 0x00, 0xc0, 0xff, 0xff, 0xff, 0x1f, 0x00 },  /* 31 */
+	{ 0x00, 0x00, 0xe0, 0xff, 0xff, 0xff, 0x1f, 0x00 },  /* 32 */
+	{ 0x00, 0x00, 0xf0, 0xff, 0xff, 0xff, 0x1f, 0x00 },  /* 33 */
+	{ 0x00, 0x00, 0xf8, 0xff, 0xff, 0xff, 0x1f, 0x00 },  /* 34 */
+	{ 0x00, 0x00, 0xfc, 0xff, 0xff, 0xff, 0x1f, 0x00 },  /* 35 */
+	{ 0x00, 0x00, 0xfe, 0xff, 0xff, 0xff, 0x1f, 0x00 },  /* 36 */
+	{ 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x1f, 0x00 },  /* 37 */
+	{ 0x00, 0x80, 0xff, 0xff, 0xff, 0xff, 0x1f, 0x00 },  /* 38 */
+	{ 0x00, 0xc0, 0xff, 0xff, 0xff, 0xff, 0x1f, 0x00 },  /* 39 */
+	{ 0x00, 0xe0, 0xff, 0xff, 0xff, 0xff, 0x1f, 0x00 },  /* 40 */
+	{ 0x00, 0xf0, 0xff, 0xff, 0xff, 0xff, 0x1f, 0x00 },  /* 41 */
+	{ 0x00, 0xf8, 0xff, 0xff, 0xff, 0xff, 0x1f, 0x00 },  /* 42 */
+	{ 0x00, 0xfc, 0xff, 0xff, 0xff, 0xff, 0x1f, 0x00 },  /* 43 */
+	{ 0x00, 0xfe, 0xff, 0xff, 0xff, 0xff, 0x1f, 0x00 },  /* 44 */
+	{ 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0x1f, 0x00 },  /* 45 */
+	{ 0x80, 0xff, 0xff, 0xff, 0xff, 0xff, 0x1f, 0x00 },  /* 46 */
+	{ 0xc0, 0xff, 0xff, 0xff, 0xff, 0xff, 0x1f, 0x00 },  /* 47 */
+	{ 0xe0, 0xff, 0xff, 0xff, 0xff, 0xff, 0x1f, 0x00 },  /* 48 */
+	{ 0xf0, 0xff, 0xff, 0xff, 0xff, 0xff, 0x1f, 0x00 },  /* 49 */
+	{ 0xf8, 0xff, 0xff, 0xff, 0xff, 0xff, 0x1f, 0x00 },  /* 50 */
+	{ 0xfc, 0xff, 0xff, 0xff, 0xff, 0xff, 0x1f, 0x00 },  /* 51 */
+	{ 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0x1f, 0x00 },  /* 52 */
+};
+
+const uint8_t oled_atlasPeak[OLED_BAR_MAX + 1][OLED_PAGES] = {
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  /*  0 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00 },  /*  1 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00 },  /*  2 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00 },  /*  3 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00 },  /*  4 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00 },  /*  5 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00 },  /*  6 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00 },  /*  7 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00 },  /*  8 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00 },  /*  9 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00 },  /* 10 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00 },  /* 11 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00 },  /* 12 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00 },  /* 13 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00 },  /* 14 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00 },  /* 15 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00 },  /* 16 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00 },  /* 17 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00 },  /* 18 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00 },  /* 19 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00 },  /* 20 */
+	{ 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00 },  /* 21 */
+	{ 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00 },  /* 22 */
+	{ 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00 },  /* 23 */
+	{ 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00 },  /* 24 */
+	{ 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00 },  /* 25 */
+	{ 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00 },  /* 26 */
+	{ 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00 },  /* 27 */
+	{ 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00 },  /* 28 */
+	{ 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00 },  /* 29 */
+	{ 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00 },  /* 30 */
+	{ 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00 },  /* 31 */
+	{ 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00 },  /* 32 */
+	{ 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00 },  /* 33 */
+	{ 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00 },  /* 34 */
+	{ 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00 },  /* 35 */
+	{ 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00 },  /* 36 */
+	{ 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00 },  /* 37 */
+	{ 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  /* 38 */
+	{ 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  /* 39 */
+	{ 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  /* 40 */
+	{ 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  /* 41 */
+	{ 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  /* 42 */
+	{ 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  /* 43 */
+	{ 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  /* 44 */
+	{ 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  /* 45 */
+	{ 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  /* 46 */
+	{ 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  /* 47 */
+	{ 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  /* 48 */
+	{ 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  /* 49 */
+	{ 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  /* 50 */
+	{ 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  /* 51 */
+	{ 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  /* 52 */
+};
+
+const uint8_t oled_atlasNum[OLED_BAND_NUM][OLED_NUM_PAGES][OLED_BAND_WIDTH] = {
+	{  /* 1 */
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x7f, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+	},
+	{  /* 2 */
+		{ 0x00, 0x00, 0x00, 0x00, 0x80, 0x40, 0x40, 0x40, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00 },
+		{ 0x00, 0x00, 0x00, 0x00, 0x60, 0x50, 0x48, 0x44, 0x43, 0x00, 0x00, 0x00, 0x00, 0x00 },
+	},
+	{  /* 3 */
+		{ 0x00, 0x00, 0x00, 0x00, 0x80, 0x40, 0x40, 0x40, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00 },
+		{ 0x00, 0x00, 0x00, 0x00, 0x20, 0x40, 0x44, 0x44, 0x3b, 0x00, 0x00, 0x00, 0x00, 0x00 },
+	},
+	{  /* 4 */
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+		{ 0x00, 0x00, 0x00, 0x00, 0x0e, 0x09, 0x08, 0x7f, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00 },
+	},
+	{  /* 5 */
+		{ 0x00, 0x00, 0x00, 0x00, 0xc0, 0x40, 0x40, 0x40, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00 },
+		{ 0x00, 0x00, 0x00, 0x00, 0x23, 0x42, 0x42, 0x42, 0x3c, 0x00, 0x00, 0x00, 0x00, 0x00 },
+	},
+	{  /* 6 */
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x40, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+		{ 0x00, 0x00, 0x00, 0x00, 0x3f, 0x44, 0x44, 0x44, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00 },
+	},
+	{  /* 7 */
+		{ 0x00, 0x00, 0x00, 0x00, 0x40, 0x40, 0x40, 0x40, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00 },
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x18, 0x06, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00 },
+	},
+	{  /* 8 */
+		{ 0x00, 0x00, 0x00, 0x00, 0x80, 0x40, 0x40, 0x40, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00 },
+		{ 0x00, 0x00, 0x00, 0x00, 0x3b, 0x44, 0x44, 0x44, 0x3b, 0x00, 0x00, 0x00, 0x00, 0x00 },
+	},
+};
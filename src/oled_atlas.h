@@ -0,0 +1,45 @@
+/**
+ *@file oled_atlas.h
+ *
+ *@brief
+ *  - precomputed OLED meter graphics in framebuffer page bytes
+ *  - oled_atlas.c is generated by tools/oledatlas.c, rerun it after
+ *    changing the layout in oled.h
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#ifndef __OLED_ATLAS_H__
+#define __OLED_ATLAS_H__
+
+#include "oled.h"
+
+/***************************************************
+            DEFINES
+***************************************************/
+
+/** pages covered by the band numbers */
+#define OLED_NUM_PAGE0  (OLED_NUM_TOP / 8)
+#define OLED_NUM_PAGES  ((OLED_NUM_TOP + OLED_NUM_HEIGHT - 1) / 8 - OLED_NUM_PAGE0 + 1)
+
+/***************************************************
+            DATA
+***************************************************/
+
+/** rows of each page that belong to the bar area */
+extern const uint8_t oled_atlasBarMask[OLED_PAGES];
+
+/** one bar column per height (0..OLED_BAR_MAX), bar rows only */
+extern const uint8_t oled_atlasBar[OLED_BAR_MAX + 1][OLED_PAGES];
+
+/** peak marker per height (0 = none), bar rows only */
+extern const uint8_t oled_atlasPeak[OLED_BAR_MAX + 1][OLED_PAGES];
+
+/** number of each band, placed in the band, pages OLED_NUM_PAGE0.. */
+extern const uint8_t oled_atlasNum[OLED_BAND_NUM][OLED_NUM_PAGES][OLED_BAND_WIDTH];
+
+#endif
@@ -0,0 +1,204 @@
+/**
+ *@file recorder.c
+ *
+ *@brief
+ *  - capture-to-memory recorder with WAV snapshot export
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#include <string.h>
+#include "recorder.h"
+#include "fileIo.h"
+#include "zedboard_freertos.h"
+
+#define malloc(size) pvPortMalloc(size)
+
+/* WAV header size (RIFF + fmt + data chunk headers) */
+#define WAV_HEADER_BYTES 44
+
+/** sink for exported bytes */
+typedef int (*recorder_write_t)(void *pCtx, const void *pBuf, unsigned int len);
+
+/* Initialize recorder */
+int recorder_init(recorder_t *pThis, short *pRing, unsigned int seconds, unsigned int sampleRate)
+{
+	if (NULL == pThis || 0 == seconds) {
+		printf("[REC]: Failed Init\r\n");
+		return -1;
+	}
+
+	pThis->size       = RECORDER_RING_SAMPLES(seconds, sampleRate);
+	pThis->sampleRate = sampleRate;
+	pThis->write      = 0;
+	pThis->wrapped    = 0;
+	pThis->freezeReq  = 0;
+	pThis->busy       = 0;
+	pThis->frozen     = 0;
+	pThis->pRing      = (NULL != pRing) ? pRing : malloc(pThis->size * sizeof(short));
+	if (NULL == pThis->pRing) {
+		printf("[REC]: Failed to allocate %u samples, recorder disabled\r\n", pThis->size);
+		pThis->size = 0;
+		return -1;
+	}
+
+	return PASS;
+}
+
+/* Retain an RX chunk */
+void recorder_put(recorder_t *pThis, const chunk_d_t *pChunk)
+{
+	unsigned int samples = pChunk->bytesUsed / sizeof(unsigned int);
+	const short *pSrc = pChunk->s16_buff;
+	unsigned int first;
+
+	if (NULL == pThis->pRing) {
+		return;
+	}
+
+	/* a freeze requested before this chunk: leave the ring alone */
+	taskENTER_CRITICAL();
+	if (pThis->freezeReq) {
+		pThis->frozen = 1;
+		taskEXIT_CRITICAL();
+		return;
+	}
+	pThis->busy = 1;
+	taskEXIT_CRITICAL();
+
+	/* chunk larger than the whole ring: keep its tail only */
+	if (samples > pThis->size) {
+		pSrc   += samples - pThis->size;
+		samples = pThis->size;
+	}
+
+	first = pThis->size - pThis->write;
+	if (first > samples) {
+		first = samples;
+	}
+
+	memcpy(&pThis->pRing[pThis->write], pSrc, first * sizeof(short));
+	if (samples > first) {
+		memcpy(pThis->pRing, &pSrc[first], (samples - first) * sizeof(short));
+	}
+
+	pThis->write += samples;
+	if (pThis->write >= pThis->size) {
+		pThis->write  -= pThis->size;
+		pThis->wrapped = 1;
+	}
+
+	/* a freeze requested during the copy waited for this chunk */
+	taskENTER_CRITICAL();
+	pThis->busy = 0;
+	if (pThis->freezeReq) {
+		pThis->frozen = 1;
+	}
+	taskEXIT_CRITICAL();
+}
+
+/* Freeze the ring */
+void recorder_freeze(recorder_t *pThis)
+{
+	/* no put in progress: frozen right away, else the put acknowledges */
+	taskENTER_CRITICAL();
+	pThis->freezeReq = 1;
+	if (!pThis->busy) {
+		pThis->frozen = 1;
+	}
+	taskEXIT_CRITICAL();
+
+	while (!pThis->frozen) {
+		vTaskDelay(1);
+	}
+}
+
+/* Resume capture */
+void recorder_resume(recorder_t *pThis)
+{
+	taskENTER_CRITICAL();
+	pThis->freezeReq = 0;
+	pThis->frozen    = 0;
+	taskEXIT_CRITICAL();
+}
+
+static void wr16(unsigned char *p, unsigned int v) { p[0] = v; p[1] = v >> 8; }
+static void wr32(unsigned char *p, unsigned int v) { wr16(p, v); wr16(p + 2, v >> 16); }
+
+/** Write snapshot as WAV (header + oldest..newest samples) to a sink
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure.
+ */
+static int recorder_export(recorder_t *pThis, recorder_write_t write, void *pCtx)
+{
+	unsigned char hdr[WAV_HEADER_BYTES];
+	unsigned int samples, start, first;
+
+	recorder_freeze(pThis);
+
+	samples = pThis->wrapped ? pThis->size : pThis->write;
+	start   = pThis->wrapped ? pThis->write : 0;
+
+	if (NULL == pThis->pRing) {
+		printf("[REC]: recorder disabled, nothing to export\r\n");
+		return -1;
+	}
+
+	/* RIFF header, 16 bit PCM stereo (ring holds L,R frames) */
+	memcpy(hdr, "RIFF", 4);
+	wr32(hdr + 4, WAV_HEADER_BYTES - 8 + samples * 2);
+	memcpy(hdr + 8, "WAVEfmt ", 8);
+	wr32(hdr + 16, 16);
+	wr16(hdr + 20, 1);
+	wr16(hdr + 22, RECORDER_CHANNELS);
+	wr32(hdr + 24, pThis->sampleRate);
+	wr32(hdr + 28, pThis->sampleRate * 2 * RECORDER_CHANNELS);
+	wr16(hdr + 32, 2 * RECORDER_CHANNELS);
+	wr16(hdr + 34, 16);
+	memcpy(hdr + 36, "data", 4);
+	wr32(hdr + 40, samples * 2);
+
+	if (write(pCtx, hdr, WAV_HEADER_BYTES) < 0) {
+		return -1;
+	}
+
+	/* ring in two segments: start..end, 0..write */
+	first = pThis->size - start;
+	if (first > samples) {
+		first = samples;
+	}
+	if (write(pCtx, &pThis->pRing[start], first * sizeof(short)) < 0) {
+		return -1;
+	}
+	if (samples > first && write(pCtx, pThis->pRing, (samples - first) * sizeof(short)) < 0) {
+		return -1;
+	}
+
+	return PASS;
+}
+
+/* file sink */
+static int recorder_writeFile(void *pCtx, const void *pBuf, unsigned int len)
+{
+	return (fileIo_write((fileIo_t *) pCtx, pBuf, len) == (int) len) ? (int) len : -1;
+}
+
+/* Export snapshot to a file */
+int recorder_exportFile(recorder_t *pThis, const char *path)
+{
+	fileIo_t file;
+	int status;
+
+	if (PASS != fileIo_open(&file, path, FILEIO_WRITE)) {
+		return -1;
+	}
+	status = recorder_export(pThis, recorder_writeFile, &file);
+	fileIo_close(&file);
+	return status;
+}
+
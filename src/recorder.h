@@ -0,0 +1,117 @@
+/**
+ *@file recorder.h
+ *
+ *@brief
+ *  - keeps the last N seconds of RX audio in a preallocated ring
+ *  - the RX stream is interleaved L,R (one sample per FIFO word), the ring
+ *    keeps it as it is and the export is a 2 channel WAV
+ *  - snapshot export as WAV to a file (the stdout UART is shared with
+ *    every task's printf, a binary dump there would be corrupted); the
+ *    file needs FILEIO_FATFS, without it capture runs but export fails
+ *  - the player exports on the up+down button chord (audioPlayer_snapshot())
+ *
+ * recorder_put() copies a chunk with at most two memcpy calls (split at
+ * the ring wrap), so the cost per chunk is one bulk copy and nothing is
+ * allocated after init.
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#ifndef _RECORDER_H_
+#define _RECORDER_H_
+
+#include "chunk_d.h"
+
+/***************************************************
+            DEFINES
+***************************************************/
+
+/**
+ * @def RECORDER_SECONDS
+ * @brief default length of the capture ring (192 KB at 48 kHz)
+ */
+#define RECORDER_SECONDS 1
+
+/** channels of the captured stream (L,R interleaved) */
+#define RECORDER_CHANNELS 2
+
+/** ring length in samples */
+#define RECORDER_RING_SAMPLES(seconds, rate) ((seconds) * (rate) * RECORDER_CHANNELS)
+
+/***************************************************
+            DATA TYPES
+***************************************************/
+
+/** recorder object
+ */
+typedef struct {
+  short         *pRing;      /* capture ring (16 bit samples) */
+  unsigned int   size;       /* ring size in samples (whole L,R frames) */
+  unsigned int   write;      /* next sample to write */
+  int            wrapped;    /* ring has been filled at least once */
+  volatile int   freezeReq;  /* capture to stop (set by the exporting task) */
+  volatile int   busy;       /* recorder_put() is copying into the ring */
+  volatile int   frozen;     /* freeze acknowledged, snapshot stable */
+  unsigned int   sampleRate; /* rate written into exported WAV header */
+} recorder_t;
+
+
+/***************************************************
+            Access Methods
+***************************************************/
+
+/** Initialize recorder, ring is allocated once (or provided)
+ *
+ * Parameters:
+ * @param pThis       pointer to own object
+ * @param pRing       RECORDER_RING_SAMPLES(seconds, sampleRate) samples, NULL to allocate
+ * @param seconds     length of the ring
+ * @param sampleRate  sampling rate of the captured audio
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure (recorder stays disabled, put is a no-op).
+ */
+int recorder_init(recorder_t *pThis, short *pRing, unsigned int seconds, unsigned int sampleRate);
+
+/** Retain an RX chunk (single bulk copy, skipped while frozen)
+ *   - acknowledges a freeze request, the ring is not touched after that
+ *
+ * Parameters:
+ * @param pThis   pointer to own object
+ * @param pChunk  received chunk (not modified)
+ */
+void recorder_put(recorder_t *pThis, const chunk_d_t *pChunk);
+
+/** Freeze the ring - capture stops, contents stay stable for export
+ *   - returns once no recorder_put() is copying any more (a put in
+ *     progress finishes its chunk first), call from task context
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ */
+void recorder_freeze(recorder_t *pThis);
+
+/** Resume capture after a snapshot
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ */
+void recorder_resume(recorder_t *pThis);
+
+/** Export the frozen snapshot as WAV to a file
+ *   - freezes the recorder if it is not frozen yet
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ * @param path   file to create
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure.
+ */
+int recorder_exportFile(recorder_t *pThis, const char *path);
+
+#endif
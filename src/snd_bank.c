@@ -0,0 +1,178 @@
+/**
+ *@file snd_bank.c
+ *
+ *@brief
+ *  - IMA-ADPCM sample bank, generated by tools/wav2adpcm.c - do not edit
+ *
+ *******************************************************************************/
+#include "adpcm.h"
+
+/* beep: 4800 samples @ 48000 Hz */
+static const unsigned char beep_adpcm[2560] = {
+	0x00, 0x00, 0x00, 0x00, 0x75, 0x57, 0x53, 0x43, 0x33, 0x24, 0x22, 0x00, 0xb9, 0xce, 0xcc, 0xbc,
+	0xcc, 0xbb, 0xbc, 0xcb, 0xaa, 0x9a, 0x09, 0x21, 0x44, 0x35, 0x45, 0x33, 0x44, 0x33, 0x33, 0x34,
+	0x22, 0x11, 0x80, 0xba, 0xcd, 0xcc, 0xbc, 0xcc, 0xca, 0xba, 0xbb, 0xba, 0xab, 0x8a, 0x08, 0x43,
+	0x54, 0x53, 0x34, 0x43, 0x34, 0x33, 0x43, 0x32, 0x22, 0x01, 0x90, 0xba, 0xce, 0xdb, 0xcb, 0xcb,
+	0xcb, 0xbb, 0xbb, 0xbb, 0xab, 0x8a, 0x18, 0x53, 0x44, 0x44, 0x43, 0x43, 0x43, 0x33, 0x33, 0x23,
+	0x23, 0x11, 0x98, 0xda, 0xcc, 0xbc, 0xbd, 0xbc, 0xcb, 0xbb, 0xbb, 0xcb, 0xa9, 0x89, 0x00, 0x42,
+	0x44, 0x53, 0x43, 0x24, 0x24, 0x33, 0x33, 0x33, 0x22, 0x11, 0x98, 0xdb, 0xcc, 0xbc, 0xcc, 0xcb,
+	0xbb, 0xcb, 0xab, 0xbb, 0xaa, 0x89, 0x10, 0x52, 0x53, 0x44, 0x33, 0x35, 0x43, 0x32, 0x33, 0x33,
+	0x22, 0x01, 0x99, 0xdb, 0xcc, 0xdb, 0xcb, 0xcb, 0xbb, 0xcb, 0xab, 0xab, 0xaa, 0x88, 0x10, 0x52,
+	0x53, 0x34, 0x44, 0x33, 0x43, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98, 0xca, 0xcc, 0xdb, 0xcb, 0xcb,
+	0xbb, 0xac, 0xab, 0xab, 0xaa, 0x09, 0x28, 0x52, 0x53, 0x34, 0x44, 0x33, 0x43, 0x43, 0x22, 0x23,
+	0x21, 0x00, 0x98, 0xca, 0xcc, 0xdb, 0xcb, 0xcb, 0xbb, 0xac, 0xab, 0xab, 0xaa, 0x89, 0x11, 0x52,
+	0x53, 0x34, 0x44, 0x33, 0x43, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc,
+	0xba, 0xbb, 0xac, 0xba, 0x99, 0x89, 0x10, 0x42, 0x44, 0x34, 0x34, 0x44, 0x32, 0x43, 0x22, 0x23,
+	0x21, 0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42,
+	0x44, 0x34, 0x34, 0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc,
+	0xa6, 0xf7, 0x3e, 0x00, 0xab, 0xbb, 0xbb, 0xba, 0x99, 0x08, 0x31, 0x45, 0x34, 0x35, 0x34, 0x34,
+	0x43, 0x32, 0x32, 0x22, 0x12, 0x88, 0xa9, 0xbd, 0xcd, 0xcb, 0xac, 0xac, 0xbb, 0xac, 0xba, 0x9a,
+	0x8a, 0x88, 0x22, 0x44, 0x34, 0x35, 0x34, 0x34, 0x33, 0x34, 0x32, 0x22, 0x02, 0x80, 0xa9, 0xbd,
+	0xcd, 0xcb, 0xbc, 0xbb, 0xbc, 0xac, 0xba, 0x9a, 0x8a, 0x08, 0x21, 0x44, 0x34, 0x35, 0x34, 0x34,
+	0x43, 0x32, 0x32, 0x22, 0x12, 0x08, 0xaa, 0xbd, 0xcd, 0xcb, 0xbc, 0xbb, 0xbc, 0xac, 0xba, 0x9a,
+	0x8a, 0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x43, 0x22, 0x13, 0x11, 0x80, 0xa9, 0xcc,
+	0xcc, 0xcb, 0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a, 0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24,
+	0x33, 0x24, 0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc, 0xcb, 0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a,
+	0x8a, 0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x24, 0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc,
+	0xcc, 0xcb, 0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a, 0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24,
+	0x33, 0x24, 0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc, 0xcb, 0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a,
+	0x8a, 0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x24, 0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc,
+	0xcc, 0xcb, 0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a, 0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24,
+	0x33, 0x24, 0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc, 0xcb, 0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a,
+	0x8a, 0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x24, 0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc,
+	0xcc, 0xcb, 0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a, 0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24,
+	0x90, 0x10, 0x3d, 0x00, 0x33, 0x23, 0x33, 0x22, 0x01, 0x99, 0xdb, 0xcc, 0xdb, 0xcb, 0xcb, 0xbb,
+	0xcb, 0xab, 0xab, 0xaa, 0x88, 0x10, 0x52, 0x53, 0x34, 0x44, 0x33, 0x43, 0x43, 0x22, 0x23, 0x21,
+	0x00, 0x98, 0xca, 0xcc, 0xdb, 0xcb, 0xcb, 0xbb, 0xac, 0xab, 0xab, 0xaa, 0x09, 0x10, 0x52, 0x53,
+	0x34, 0x44, 0x33, 0x43, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba,
+	0xbb, 0xac, 0xba, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34, 0x44, 0x32, 0x43, 0x22, 0x23, 0x21,
+	0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44,
+	0x34, 0x34, 0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba,
+	0xcb, 0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34, 0x44, 0x32, 0x43, 0x22, 0x23, 0x21,
+	0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44,
+	0x34, 0x34, 0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba,
+	0xcb, 0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34, 0x44, 0x32, 0x43, 0x22, 0x23, 0x21,
+	0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44,
+	0x34, 0x34, 0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba,
+	0xcb, 0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34, 0x44, 0x32, 0x43, 0x22, 0x23, 0x21,
+	0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44,
+	0x34, 0x34, 0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba,
+	0x83, 0xe7, 0x3c, 0x00, 0xbb, 0xbb, 0xaa, 0x9a, 0x08, 0x32, 0x54, 0x44, 0x43, 0x43, 0x24, 0x33,
+	0x24, 0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc, 0xcb, 0xcb, 0xac, 0xbb, 0xcb, 0xaa, 0x9b, 0x8a,
+	0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x24, 0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc,
+	0xcb, 0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a, 0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33,
+	0x24, 0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc, 0xcb, 0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a,
+	0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x24, 0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc,
+	0xcb, 0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a, 0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33,
+	0x24, 0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc, 0xcb, 0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a,
+	0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x24, 0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc,
+	0xcb, 0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a, 0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33,
+	0x24, 0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc, 0xcb, 0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a,
+	0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x24, 0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc,
+	0xcb, 0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a, 0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33,
+	0x24, 0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc, 0xcb, 0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a,
+	0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x24, 0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc,
+	0xcb, 0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a, 0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33,
+	0xff, 0x1f, 0x3b, 0x00, 0x33, 0x23, 0x22, 0x01, 0x98, 0xdb, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb,
+	0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34, 0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00,
+	0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34,
+	0x34, 0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb,
+	0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34, 0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00,
+	0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34,
+	0x34, 0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb,
+	0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34, 0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00,
+	0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34,
+	0x34, 0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb,
+	0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34, 0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00,
+	0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34,
+	0x34, 0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb,
+	0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34, 0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00,
+	0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34,
+	0x34, 0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb,
+	0x0b, 0xd9, 0x3d, 0x00, 0xaa, 0x9a, 0x8a, 0x08, 0x21, 0x53, 0x44, 0x43, 0x24, 0x24, 0x33, 0x24,
+	0x32, 0x12, 0x02, 0x00, 0xaa, 0xcc, 0xbc, 0xbd, 0xbc, 0xbc, 0xbb, 0xbc, 0xba, 0xaa, 0x8a, 0x08,
+	0x21, 0x35, 0x45, 0x43, 0x34, 0x33, 0x34, 0x24, 0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xbc, 0xbd,
+	0xbc, 0xbc, 0xcb, 0xba, 0xba, 0xaa, 0x9a, 0x80, 0x22, 0x35, 0x45, 0x43, 0x34, 0x33, 0x34, 0x24,
+	0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc, 0xcb, 0xcb, 0xac, 0xbb, 0xcb, 0xaa, 0x9b, 0x99, 0x08,
+	0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x24, 0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc, 0xcb,
+	0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a, 0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x24,
+	0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc, 0xcb, 0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a, 0x08,
+	0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x24, 0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc, 0xcb,
+	0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a, 0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x24,
+	0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc, 0xcb, 0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a, 0x08,
+	0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x24, 0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc, 0xcb,
+	0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a, 0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x24,
+	0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc, 0xcb, 0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a, 0x08,
+	0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x24, 0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc, 0xcb,
+	0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a, 0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x24,
+	0x40, 0x2d, 0x3c, 0x00, 0x22, 0x11, 0x01, 0x98, 0xba, 0xcd, 0xbc, 0xcc, 0xbb, 0xcb, 0xcb, 0xaa,
+	0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34, 0x44, 0x32, 0x33, 0x24, 0x32, 0x11, 0x01, 0x98,
+	0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34,
+	0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa,
+	0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34, 0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98,
+	0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34,
+	0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa,
+	0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34, 0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98,
+	0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34,
+	0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa,
+	0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34, 0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98,
+	0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34,
+	0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa,
+	0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34, 0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98,
+	0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34,
+	0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa,
+	0x3b, 0xcd, 0x3b, 0x00, 0x9a, 0x99, 0x08, 0x21, 0x53, 0x44, 0x43, 0x34, 0x33, 0x34, 0x24, 0x32,
+	0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc, 0xcb, 0xcb, 0xac, 0xbb, 0xcb, 0xaa, 0x9b, 0x8a, 0x08, 0x21,
+	0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x24, 0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc, 0xcb, 0xcb,
+	0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a, 0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x24, 0x32,
+	0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc, 0xcb, 0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a, 0x08, 0x21,
+	0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x24, 0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc, 0xcb, 0xcb,
+	0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a, 0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x24, 0x32,
+	0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc, 0xcb, 0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a, 0x08, 0x21,
+	0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x24, 0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc, 0xcb, 0xcb,
+	0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a, 0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x24, 0x32,
+	0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc, 0xcb, 0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a, 0x08, 0x21,
+	0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x24, 0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc, 0xcb, 0xcb,
+	0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a, 0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x24, 0x32,
+	0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc, 0xcb, 0xcb, 0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a, 0x08, 0x21,
+	0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x24, 0x32, 0x12, 0x02, 0x80, 0xa9, 0xcc, 0xcc, 0xcb, 0xcb,
+	0xac, 0xbb, 0xac, 0xba, 0x9a, 0x8a, 0x08, 0x21, 0x44, 0x44, 0x43, 0x43, 0x24, 0x33, 0x24, 0x32,
+	0x6c, 0x37, 0x3a, 0x00, 0x12, 0x00, 0x98, 0xba, 0xcd, 0xbc, 0xcc, 0xca, 0xba, 0xcb, 0xaa, 0xab,
+	0xa9, 0x88, 0x10, 0x42, 0x44, 0x53, 0x43, 0x43, 0x33, 0x43, 0x23, 0x23, 0x22, 0x00, 0x98, 0xda,
+	0xdb, 0xbc, 0xcc, 0xbb, 0xcb, 0xcb, 0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x53, 0x43, 0x43,
+	0x33, 0x24, 0x23, 0x23, 0x22, 0x81, 0x98, 0xda, 0xdb, 0xbc, 0xcc, 0xca, 0xba, 0xcb, 0xaa, 0xab,
+	0x9a, 0x88, 0x10, 0x42, 0x44, 0x53, 0x43, 0x43, 0x33, 0x24, 0x23, 0x23, 0x22, 0x81, 0x98, 0xda,
+	0xdb, 0xbc, 0xcc, 0xbb, 0xcb, 0xcb, 0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34, 0x44,
+	0x32, 0x33, 0x24, 0x32, 0x11, 0x01, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa, 0xab,
+	0xa9, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34, 0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98, 0xca,
+	0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34, 0x44,
+	0x32, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa, 0xab,
+	0xa9, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34, 0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98, 0xca,
+	0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34, 0x44,
+	0x32, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa, 0xab,
+	0xa9, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34, 0x44, 0x32, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98, 0xca,
+	0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa, 0xab, 0xa9, 0x88, 0x10, 0x42, 0x44, 0x34, 0x34, 0x44,
+	0x32, 0x43, 0x22, 0x23, 0x21, 0x00, 0x98, 0xca, 0xcc, 0xbc, 0xbc, 0xcc, 0xba, 0xcb, 0xaa, 0xab,
+	0xe0, 0xc4, 0x39, 0x00, 0x99, 0x08, 0x31, 0x53, 0x34, 0x35, 0x34, 0x34, 0x33, 0x24, 0x23, 0x22,
+	0x11, 0x90, 0xb9, 0xcc, 0xbd, 0xbc, 0xbc, 0xbc, 0xbb, 0xcb, 0xba, 0x9a, 0x99, 0x18, 0x31, 0x44,
+	0x44, 0x43, 0x34, 0x33, 0x34, 0x33, 0x23, 0x23, 0x11, 0x90, 0xba, 0xcd, 0xcc, 0xcb, 0xcb, 0xbb,
+	0xbc, 0xba, 0xbb, 0xaa, 0x99, 0x00, 0x32, 0x45, 0x34, 0x35, 0x43, 0x43, 0x32, 0x33, 0x33, 0x22,
+	0x11, 0x98, 0xc9, 0xbc, 0xcd, 0xcb, 0xbb, 0xbc, 0xac, 0xbb, 0xaa, 0xaa, 0x99, 0x10, 0x31, 0x45,
+	0x53, 0x43, 0x33, 0x34, 0x43, 0x32, 0x22, 0x12, 0x01, 0x90, 0xba, 0xdc, 0xcb, 0xbc, 0xcb, 0xcb,
+	0xba, 0xba, 0xab, 0x9a, 0x89, 0x10, 0x33, 0x45, 0x53, 0x33, 0x34, 0x24, 0x33, 0x32, 0x32, 0x11,
+	0x00, 0x99, 0xcb, 0xbc, 0xbd, 0xcb, 0xcb, 0xaa, 0xab, 0xaa, 0x99, 0x09, 0x10, 0x32, 0x34, 0x34,
+	0x24, 0x22, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+const adpcm_clip_t snd_bank[] = {
+	{ "beep", beep_adpcm, 2560, 256, 4800, 48000 },
+};
+
+const unsigned int snd_bank_nClips = 1;
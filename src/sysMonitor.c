@@ -0,0 +1,218 @@
+/**
+ *@file sysMonitor.c
+ *
+ *@brief
+ *  - per-task CPU load and stack high-water monitoring
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#include <string.h>
+#include "sysMonitor.h"
+#include "timeStamp.h"
+#include "appConfig.h"
+#include "zedboard_freertos.h"
+
+/* run-time counter resolution: time stamp / 256 (~1.3 MHz) */
+#define SYSMON_RUNTIME_SHIFT 8
+
+/** tracked task */
+typedef struct {
+  int            used;                  /* slot in use */
+  int            seen;                  /* present in the last sample */
+  UBaseType_t    number;                /* FreeRTOS task number */
+  const char    *name;                  /* task name */
+  unsigned int   lastRun;               /* run-time counter at last sample */
+  unsigned int   delta[SYSMON_WINDOW];  /* run-time per sample in window */
+  unsigned int   windowRun;             /* sum of delta[] */
+  unsigned short load;                  /* 1/1000 over window */
+  unsigned short stackFree;             /* high-water mark (words) */
+  unsigned char  priority;              /* current priority */
+} sysMonitor_slot_t;
+
+static sysMonitor_slot_t sysMonitor_slots[SYSMON_MAX_TASKS];
+static unsigned int      sysMonitor_totalDelta[SYSMON_WINDOW];
+static unsigned int      sysMonitor_windowTotal;
+static unsigned int      sysMonitor_lastTotal;
+static unsigned int      sysMonitor_index;
+static unsigned int      sysMonitor_load;
+
+/* Start the free-running counter */
+void sysMonitor_runTimeInit(void)
+{
+	timeStamp_init();
+}
+
+/* 64 bit global timer scaled into a 32 bit counter that wraps at 2^32 */
+unsigned int sysMonitor_runTimeCounter(void)
+{
+	unsigned int hi, lo;
+
+	do {
+		hi = *(volatile unsigned int *) GTIMER_COUNTER_HI;
+		lo = *(volatile unsigned int *) GTIMER_COUNTER_LO;
+	} while (hi != *(volatile unsigned int *) GTIMER_COUNTER_HI);
+
+	return (hi << (32 - SYSMON_RUNTIME_SHIFT)) | (lo >> SYSMON_RUNTIME_SHIFT);
+}
+
+#if SYSMON_ENABLED
+
+/** find the slot of a task, allocate one for new tasks
+ *
+ * @return slot, NULL if all slots are in use
+ */
+static sysMonitor_slot_t *sysMonitor_slot(const TaskStatus_t *pStatus)
+{
+	sysMonitor_slot_t *pFree = NULL;
+	int i;
+
+	for (i = 0; i < SYSMON_MAX_TASKS; i++) {
+		if (sysMonitor_slots[i].used && sysMonitor_slots[i].number == pStatus->xTaskNumber) {
+			return &sysMonitor_slots[i];
+		}
+		if (!sysMonitor_slots[i].used && NULL == pFree) {
+			pFree = &sysMonitor_slots[i];
+		}
+	}
+
+	if (NULL != pFree) {
+		memset(pFree, 0, sizeof(*pFree));
+		pFree->used    = 1;
+		pFree->number  = pStatus->xTaskNumber;
+		pFree->lastRun = pStatus->ulRunTimeCounter;
+	}
+	return pFree;
+}
+
+/** take one sample of all tasks and update the window */
+static void sysMonitor_sample(void)
+{
+	static TaskStatus_t status[SYSMON_MAX_TASKS];
+	uint32_t total = 0;
+	unsigned int totalDelta;
+	UBaseType_t n, count;
+	int i;
+
+	count = uxTaskGetSystemState(status, SYSMON_MAX_TASKS, &total);
+
+	totalDelta = total - sysMonitor_lastTotal;
+	sysMonitor_lastTotal = total;
+
+	taskENTER_CRITICAL();
+	sysMonitor_windowTotal += totalDelta - sysMonitor_totalDelta[sysMonitor_index];
+	sysMonitor_totalDelta[sysMonitor_index] = totalDelta;
+
+	for (i = 0; i < SYSMON_MAX_TASKS; i++) {
+		sysMonitor_slots[i].seen = 0;
+	}
+
+	for (n = 0; n < count; n++) {
+		sysMonitor_slot_t *pSlot = sysMonitor_slot(&status[n]);
+		unsigned int delta;
+
+		if (NULL == pSlot) {
+			continue;
+		}
+
+		delta = status[n].ulRunTimeCounter - pSlot->lastRun;
+		pSlot->lastRun    = status[n].ulRunTimeCounter;
+		pSlot->windowRun += delta - pSlot->delta[sysMonitor_index];
+		pSlot->delta[sysMonitor_index] = delta;
+
+		pSlot->seen      = 1;
+		pSlot->name      = status[n].pcTaskName;
+		pSlot->priority  = status[n].uxCurrentPriority;
+		pSlot->stackFree = status[n].usStackHighWaterMark;
+		pSlot->load      = sysMonitor_windowTotal ?
+				(unsigned short) (((unsigned long long) pSlot->windowRun * 1000) / sysMonitor_windowTotal) : 0;
+
+		/* everything that is not idle counts as load */
+		if (0 == strcmp(pSlot->name, "IDLE")) {
+			sysMonitor_load = 1000 - pSlot->load;
+		}
+	}
+
+	/* forget deleted tasks */
+	for (i = 0; i < SYSMON_MAX_TASKS; i++) {
+		if (!sysMonitor_slots[i].seen) {
+			sysMonitor_slots[i].used = 0;
+		}
+	}
+
+	sysMonitor_index = (sysMonitor_index + 1) % SYSMON_WINDOW;
+	taskEXIT_CRITICAL();
+}
+
+/** monitor task: sample every SYSMON_PERIOD_MS
+ *
+ *@param pArg  unused
+ */
+static void sysMonitor_task(void *pArg)
+{
+	TickType_t lastWake = xTaskGetTickCount();
+
+	for (;;) {
+		vTaskDelayUntil(&lastWake, SYSMON_PERIOD_MS / portTICK_PERIOD_MS);
+		sysMonitor_sample();
+	}
+}
+
+/* Create the monitor task */
+int sysMonitor_start(void)
+{
+	APP_TASK_CREATE_LOCAL( sysMonitor_task, "MON", MON_TASK_STACK, NULL, MON_TASK_PRIO );
+	return PASS;
+}
+
+#endif
+
+/* Total CPU load */
+unsigned int sysMonitor_getLoad(void)
+{
+	return sysMonitor_load;
+}
+
+/* Build the binary report */
+unsigned int sysMonitor_getReport(unsigned char *pBuf, unsigned int len)
+{
+	sysMonitor_reportHdr_t *pHdr = (sysMonitor_reportHdr_t *) pBuf;
+	sysMonitor_reportEntry_t *pEntry = (sysMonitor_reportEntry_t *) (pHdr + 1);
+	unsigned int bytes = sizeof(*pHdr);
+	int i;
+
+	if (len < sizeof(*pHdr) + SYSMON_MAX_TASKS * sizeof(*pEntry)) {
+		return 0;
+	}
+
+	pHdr->magic[0]     = SYSMON_REPORT_MAGIC0;
+	pHdr->magic[1]     = SYSMON_REPORT_MAGIC1;
+	pHdr->version      = SYSMON_REPORT_VERSION;
+	pHdr->nTasks       = 0;
+	pHdr->loadPermille = sysMonitor_load;
+
+	taskENTER_CRITICAL();
+	for (i = 0; i < SYSMON_MAX_TASKS; i++) {
+		const sysMonitor_slot_t *pSlot = &sysMonitor_slots[i];
+
+		if (!pSlot->used) {
+			continue;
+		}
+		pEntry->taskNumber     = pSlot->number;
+		pEntry->priority       = pSlot->priority;
+		pEntry->loadPermille   = pSlot->load;
+		pEntry->stackFreeWords = pSlot->stackFree;
+		strncpy(pEntry->name, pSlot->name, SYSMON_NAME_LEN);
+
+		pHdr->nTasks++;
+		pEntry++;
+		bytes += sizeof(*pEntry);
+	}
+	taskEXIT_CRITICAL();
+
+	return bytes;
+}
@@ -0,0 +1,127 @@
+/**
+ *@file sysMonitor.h
+ *
+ *@brief
+ *  - per-task CPU load and stack high-water monitoring
+ *
+ * The monitor task samples the FreeRTOS run-time counters of all tasks
+ * every SYSMON_PERIOD_MS and keeps the last SYSMON_WINDOW samples, so the
+ * reported load is averaged over a sliding window of
+ * SYSMON_PERIOD_MS * SYSMON_WINDOW.
+ *
+ * Needs configUSE_TRACE_FACILITY and configGENERATE_RUN_TIME_STATS in
+ * FreeRTOSConfig.h (BSP settings), with the run-time counter hooked up as:
+ *   #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() sysMonitor_runTimeInit()
+ *   #define portGET_RUN_TIME_COUNTER_VALUE()        sysMonitor_runTimeCounter()
+ * Without them SYSMON_ENABLED is 0: there is no monitor task and callers
+ * leave out what depends on the load (OLED load line, busy check).
+ *
+ * The stock BSP of this project has both options off, so by default the
+ * monitor is NOT built. To enable it:
+ *   1. BSP settings, freertos kernel features: use_trace_facility and
+ *      generate_run_time_stats on (sets the two config options)
+ *   2. add the two port macros above to the BSP's FreeRTOSConfig.h
+ *   3. rebuild the BSP and the application, SYSMON_ENABLED follows
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#ifndef _SYS_MONITOR_H_
+#define _SYS_MONITOR_H_
+
+#include "zedboard_freertos.h"
+
+/***************************************************
+            DEFINES
+***************************************************/
+
+/**
+ * @def SYSMON_ENABLED
+ * @brief 1: kernel keeps run-time stats, monitor available
+ */
+#ifndef SYSMON_ENABLED
+#if defined(configUSE_TRACE_FACILITY) && (configUSE_TRACE_FACILITY == 1) \
+	&& defined(configGENERATE_RUN_TIME_STATS) && (configGENERATE_RUN_TIME_STATS == 1)
+#define SYSMON_ENABLED 1
+#else
+#define SYSMON_ENABLED 0
+#endif
+#endif
+
+/** sampling period of the monitor task */
+#define SYSMON_PERIOD_MS 250
+
+/** samples in the sliding window */
+#define SYSMON_WINDOW 8
+
+/** tasks that can be tracked */
+#define SYSMON_MAX_TASKS 12
+
+/** characters of the task name in the binary report */
+#define SYSMON_NAME_LEN 4
+
+/** binary report identification */
+#define SYSMON_REPORT_MAGIC0   'S'
+#define SYSMON_REPORT_MAGIC1   'M'
+#define SYSMON_REPORT_VERSION  1
+
+/***************************************************
+            DATA TYPES
+***************************************************/
+
+/** binary report header (followed by nTasks entries) */
+typedef struct __attribute__ ((packed)) {
+  unsigned char  magic[2];     /* 'S' 'M' */
+  unsigned char  version;      /* SYSMON_REPORT_VERSION */
+  unsigned char  nTasks;       /* entries following */
+  unsigned short loadPermille; /* total CPU load (everything but idle) */
+} sysMonitor_reportHdr_t;
+
+/** binary report entry, one per task */
+typedef struct __attribute__ ((packed)) {
+  unsigned char  taskNumber;          /* FreeRTOS task number */
+  unsigned char  priority;            /* current priority */
+  unsigned short loadPermille;        /* CPU load over the window */
+  unsigned short stackFreeWords;      /* stack high-water mark (min free) */
+  char           name[SYSMON_NAME_LEN]; /* task name, not terminated */
+} sysMonitor_reportEntry_t;
+
+
+/***************************************************
+            Access Methods
+***************************************************/
+
+/** Create the monitor task (SYSMON_ENABLED only)
+ *
+ * @return PASS/Zero on success.
+ * FAIL/Negative value on failure.
+ */
+int sysMonitor_start(void);
+
+/** Total CPU load over the window (all tasks except idle)
+ *
+ * @return load in 1/1000, always 0 without SYSMON_ENABLED
+ */
+unsigned int sysMonitor_getLoad(void);
+
+/** Build the binary report
+ *   - for a debugger or a link of its own, the console UART is shared
+ *     with every task's printf
+ *
+ * Parameters:
+ * @param pBuf  destination
+ * @param len   size of pBuf
+ *
+ * @return bytes written, 0 if pBuf is too small
+ */
+unsigned int sysMonitor_getReport(unsigned char *pBuf, unsigned int len);
+
+/** run-time stats counter hooks (see file header) */
+void sysMonitor_runTimeInit(void);
+unsigned int sysMonitor_runTimeCounter(void);
+
+#endif
@@ -0,0 +1,44 @@
+/**
+ *@file timeStamp.h
+ *
+ *@brief
+ *  - free-running cycle counter for time stamps and profiling
+ *  - Cortex-A9 MPCore global timer (64 bit, clocked at CPU_CLK/2),
+ *    the low word is used and wraps every ~13 s at 333 MHz
+ *
+ * Target:   Xilinx Zynq Zedboard
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#ifndef _TIME_STAMP_H_
+#define _TIME_STAMP_H_
+
+#include "xparameters.h"
+
+/* Global timer MMRs, Refer Cortex-A9 MPCore TRM 4.4 */
+#define GTIMER_BASE        0xF8F00200
+#define GTIMER_COUNTER_LO  (GTIMER_BASE + 0x00)  /**< Counter, lower 32 bits */
+#define GTIMER_COUNTER_HI  (GTIMER_BASE + 0x04)  /**< Counter, upper 32 bits */
+#define GTIMER_CONTROL     (GTIMER_BASE + 0x08)  /**< Control, bit 0 = enable */
+
+/**
+ * @def TIMESTAMP_HZ
+ * @brief time stamp counter frequency
+ */
+#define TIMESTAMP_HZ (XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ / 2)
+
+/** convert a time stamp difference to microseconds */
+#define TIMESTAMP_TO_US(ticks) ((unsigned int) (((unsigned long long) (ticks) * 1000000) / TIMESTAMP_HZ))
+
+/** convert microseconds to time stamp ticks */
+#define TIMESTAMP_FROM_US(us) ((unsigned int) (((unsigned long long) (us) * TIMESTAMP_HZ) / 1000000))
+
+/** start the counter (already running when the BSP uses XTime) */
+#define timeStamp_init() (*(volatile unsigned int *) GTIMER_CONTROL |= 0x1)
+
+/** current time stamp (low 32 bits, use unsigned differences) */
+#define timeStamp_get() (*(volatile unsigned int *) GTIMER_COUNTER_LO)
+
+#endif
@@ -0,0 +1,34 @@
+/**
+ *@file uiEvents.h
+ *
+ *@brief
+ *  - control plane event bits between the button/timer interrupts and the
+ *    GPIO and TTC tasks
+ *  - carried in the receiving task's notification value (eSetBits), so an
+ *    interrupt sets a bit without a queue copy and repeated events
+ *    coalesce until the task runs
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#ifndef _UI_EVENTS_H_
+#define _UI_EVENTS_H_
+
+/** TTC task: base tick of the UI scheduler */
+#define UI_EVT_REFRESH   (1 << 0)
+
+/** TTC task: run all UI jobs now (state change) */
+#define UI_EVT_REDRAW    (1 << 3)
+
+/** GPIO task: volume buttons */
+#define UI_EVT_VOL_UP    (1 << 1)
+#define UI_EVT_VOL_DOWN  (1 << 2)
+
+/** all bits, cleared on every wait */
+#define UI_EVT_ALL       (UI_EVT_REFRESH | UI_EVT_VOL_UP | UI_EVT_VOL_DOWN | UI_EVT_REDRAW)
+
+#endif
@@ -0,0 +1,124 @@
+/**
+ *@file uiSched.c
+ *
+ *@brief
+ *  - UI job scheduler on a fixed base tick
+ *
+ * Ticks are compared with signed differences, so the 32 bit base tick
+ * may wrap.
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#include <string.h>
+#include "uiSched.h"
+#include "timeStamp.h"
+#include "zedboard_freertos.h"
+
+/* Initialize an empty scheduler */
+void uiSched_init(uiSched_t *pThis)
+{
+	memset(pThis, 0, sizeof(*pThis));
+}
+
+/* Add a job */
+int uiSched_add(uiSched_t *pThis, const char *name, uiSched_fn_t fn, void *pArg,
+		unsigned int period, unsigned int budgetUs, unsigned int flags)
+{
+	uiSched_job_t *pJob;
+
+	if (pThis->numJobs >= UISCHED_JOBS_MAX || NULL == fn || 0 == period) {
+		printf("[UI]: can not add job %s\r\n", name);
+		return -1;
+	}
+
+	pJob = &pThis->jobs[pThis->numJobs];
+	memset(pJob, 0, sizeof(*pJob));
+	pJob->name     = name;
+	pJob->fn       = fn;
+	pJob->pArg     = pArg;
+	pJob->period   = period;
+	pJob->budgetUs = budgetUs;
+	pJob->flags    = flags;
+	pJob->next     = 0;
+	return pThis->numJobs++;
+}
+
+/* Make all jobs due */
+void uiSched_trigger(uiSched_t *pThis, uint32_t now)
+{
+	unsigned int i;
+
+	for (i = 0; i < pThis->numJobs; i++) {
+		pThis->jobs[i].next = now;
+	}
+}
+
+/* Run the jobs that are due */
+unsigned int uiSched_run(uiSched_t *pThis, uint32_t now, int busy)
+{
+	unsigned int i, ran = 0;
+
+	for (i = 0; i < pThis->numJobs; i++) {
+		uiSched_job_t *pJob = &pThis->jobs[i];
+		int32_t late = (int32_t) (now - pJob->next);
+		unsigned int missed, us;
+		uint32_t start;
+
+		if (late < 0) {
+			continue;
+		}
+
+		/* slots that passed while the task did not run are dropped */
+		missed = (unsigned int) late / pJob->period;
+		pJob->skips += missed;
+		pJob->next  += (missed + 1) * pJob->period;
+
+		if (busy && (pJob->flags & UISCHED_OPTIONAL)) {
+			pJob->skips++;
+			continue;
+		}
+
+		start = timeStamp_get();
+		pJob->fn(pJob->pArg);
+		us = TIMESTAMP_TO_US(timeStamp_get() - start);
+
+		pJob->runs++;
+		ran++;
+		if (us > pJob->worstUs) {
+			pJob->worstUs = us;
+		}
+
+		/* over budget: give the time back by running less often */
+		if (pJob->budgetUs && us > pJob->budgetUs) {
+			unsigned int backoff = us / pJob->budgetUs;
+
+			if (backoff > UISCHED_BACKOFF_MAX) {
+				backoff = UISCHED_BACKOFF_MAX;
+			}
+			pJob->overruns++;
+			pJob->skips += backoff;
+			pJob->next  += backoff * pJob->period;
+		}
+	}
+
+	return ran;
+}
+
+/* Print the job statistics */
+void uiSched_printStats(const uiSched_t *pThis)
+{
+	unsigned int i;
+
+	for (i = 0; i < pThis->numJobs; i++) {
+		const uiSched_job_t *pJob = &pThis->jobs[i];
+
+		printf("[UI]: %-8s every %u ticks, runs %u, skips %u, overruns %u, worst %u/%u us\n",
+				pJob->name, pJob->period, pJob->runs, pJob->skips, pJob->overruns,
+				pJob->worstUs, pJob->budgetUs);
+	}
+}
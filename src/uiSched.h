@@ -0,0 +1,118 @@
+/**
+ *@file uiSched.h
+ *
+ *@brief
+ *  - UI job scheduler on a fixed base tick (TTC interrupt)
+ *  - every job declares its rate (in base ticks) and a run time budget
+ *  - late jobs are skipped to their next slot, never run twice to catch
+ *    up; while the system is busy optional jobs are skipped; a job that
+ *    overruns its budget is pushed back by the overrun factor
+ *
+ * Target:   Xilinx Zynq Zedboard
+ * Compiler/IDE: GCC - Xilinx SDK 2015.4
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#ifndef _UI_SCHED_H_
+#define _UI_SCHED_H_
+
+#include <stdint.h>
+
+/***************************************************
+            DEFINES
+***************************************************/
+
+/** maximum number of jobs */
+#define UISCHED_JOBS_MAX   8
+
+/** largest back-off after a budget overrun, in periods */
+#define UISCHED_BACKOFF_MAX 8
+
+/** job flags */
+#define UISCHED_OPTIONAL   (1 << 0)  /* skipped while busy */
+
+/***************************************************
+            DATA TYPES
+***************************************************/
+
+/** job function */
+typedef void (*uiSched_fn_t)(void *pArg);
+
+/** one UI job */
+typedef struct {
+  const char    *name;
+  uiSched_fn_t   fn;
+  void          *pArg;
+  unsigned int   period;    /* base ticks between runs */
+  unsigned int   budgetUs;  /* expected run time */
+  unsigned int   flags;     /* UISCHED_xxx */
+  uint32_t       next;      /* base tick of the next run */
+  uint32_t       runs;      /* times run */
+  uint32_t       skips;     /* slots skipped (late, busy or backed off) */
+  uint32_t       overruns;  /* runs over budget */
+  uint32_t       worstUs;   /* longest run */
+} uiSched_job_t;
+
+/** scheduler object */
+typedef struct {
+  uiSched_job_t  jobs[UISCHED_JOBS_MAX];
+  unsigned int   numJobs;
+} uiSched_t;
+
+
+/***************************************************
+            Access Methods
+***************************************************/
+
+/** Initialize an empty scheduler
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ */
+void uiSched_init(uiSched_t *pThis);
+
+/** Add a job, first run on the next call of uiSched_run()
+ *
+ * Parameters:
+ * @param pThis     pointer to own object
+ * @param name      job name (statistics)
+ * @param fn        job function
+ * @param pArg      argument of fn
+ * @param period    base ticks between runs
+ * @param budgetUs  run time budget in us
+ * @param flags     UISCHED_xxx
+ *
+ * @return job index, negative value on failure
+ */
+int uiSched_add(uiSched_t *pThis, const char *name, uiSched_fn_t fn, void *pArg,
+		unsigned int period, unsigned int budgetUs, unsigned int flags);
+
+/** Make all jobs due on the next uiSched_run()
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ * @param now    current base tick
+ */
+void uiSched_trigger(uiSched_t *pThis, uint32_t now);
+
+/** Run the jobs that are due
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ * @param now    current base tick
+ * @param busy   non-zero to skip optional jobs
+ *
+ * @return number of jobs run
+ */
+unsigned int uiSched_run(uiSched_t *pThis, uint32_t now, int busy);
+
+/** Print the job statistics
+ *
+ * Parameters:
+ * @param pThis  pointer to own object
+ */
+void uiSched_printStats(const uiSched_t *pThis);
+
+#endif
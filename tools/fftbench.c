@@ -0,0 +1,171 @@
+/**
+ *@file fftbench.c
+ *
+ *@brief
+ *  - host benchmark: accuracy and speed of src/fft.c
+ *
+ * For every size FFT_SIZE_MIN..FFT_SIZE_MAX: a random signal is transformed
+ * and compared against a direct DFT in double (largest error relative to
+ * the largest bin), then run through the inverse (round trip error). The
+ * Q15 variant is compared the same way as SNR in dB. Speed is the mean of
+ * repeated transforms. Built natively this measures the scalar code; built
+ * on an ARM host with -mfpu=neon it measures the NEON kernels.
+ *
+ * Build (host):
+ *   gcc -O2 -Isrc -o fftbench tools/fftbench.c src/fft.c -lm
+ *   arm-linux-gnueabihf-gcc -O2 -mfpu=neon -mfloat-abi=hard -Isrc \
+ *       -o fftbench tools/fftbench.c src/fft.c -lm
+ * Usage:
+ *   fftbench [repeats]
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "fft.h"
+
+static float  data[FFT_SIZE_MAX];
+static float  input[FFT_SIZE_MAX];
+static short  dataQ15[FFT_SIZE_MAX];
+static short  inputQ15[FFT_SIZE_MAX];
+static double refRe[FFT_SIZE_MAX / 2 + 1];
+static double refIm[FFT_SIZE_MAX / 2 + 1];
+static double cosTab[FFT_SIZE_MAX];
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* direct DFT bins 0..N/2 in double */
+static void dft(const float *pX, unsigned int n)
+{
+	unsigned int k, i;
+
+	for (i = 0; i < n; i++) {
+		cosTab[i] = cos(2.0 * M_PI * i / n);
+	}
+	for (k = 0; k <= n / 2; k++) {
+		double re = 0.0, im = 0.0;
+		unsigned int idx = 0;
+
+		for (i = 0; i < n; i++) {
+			re += pX[i] * cosTab[idx];
+			im -= pX[i] * cosTab[(idx + 3 * n / 4) % n];  /* sin = cos(x - pi/2) */
+			idx = (idx + k) % n;
+		}
+		refRe[k] = re;
+		refIm[k] = im;
+	}
+}
+
+/* packed bin k of a spectrum */
+static void bin(const float *pS, unsigned int n, unsigned int k, double *pRe, double *pIm)
+{
+	if (0 == k) {
+		*pRe = pS[0]; *pIm = 0.0;
+	} else if (n / 2 == k) {
+		*pRe = pS[1]; *pIm = 0.0;
+	} else {
+		*pRe = pS[2 * k]; *pIm = pS[2 * k + 1];
+	}
+}
+
+static double timeIt(void (*fn)(const fft_t *, void *), const fft_t *pFft, void *pData, unsigned int repeats)
+{
+	double t0 = now();
+	unsigned int r;
+
+	for (r = 0; r < repeats; r++) {
+		fn(pFft, pData);
+	}
+	return (now() - t0) / repeats * 1e6;
+}
+
+static void runFwd(const fft_t *p, void *d)    { fft_forward(p, (float *) d); }
+static void runInv(const fft_t *p, void *d)    { fft_inverse(p, (float *) d); }
+static void runFwdQ15(const fft_t *p, void *d) { fft_forwardQ15(p, (short *) d); }
+static void runInvQ15(const fft_t *p, void *d) { fft_inverseQ15(p, (short *) d); }
+
+int main(int argc, char *argv[])
+{
+	unsigned int repeats = (argc > 1) ? (unsigned int) atoi(argv[1]) : 200;
+	unsigned int n, i, k;
+
+	printf("    N  fwd err   rt err   Q15 SNR  Q15 rt SNR   fwd us   inv us  fwdQ15 us  invQ15 us\n");
+
+	for (n = FFT_SIZE_MIN; n <= FFT_SIZE_MAX; n *= 2) {
+		fft_t fft;
+		double peak = 0.0, err = 0.0, rtErr = 0.0;
+		double sig = 0.0, noise = 0.0, rtSig = 0.0, rtNoise = 0.0;
+		double tFwd, tInv, tFwdQ15, tInvQ15;
+
+		if (0 != fft_init(&fft, n)) {
+			return 1;
+		}
+
+		/* random signal at half scale */
+		for (i = 0; i < n; i++) {
+			input[i]    = (float) ((rand() / (double) RAND_MAX - 0.5));
+			inputQ15[i] = (short) (input[i] * 32767.0f);
+		}
+		dft(input, n);
+
+		/* float forward against the DFT, then the round trip */
+		for (i = 0; i < n; i++) {
+			data[i] = input[i];
+		}
+		fft_forward(&fft, data);
+		for (k = 0; k <= n / 2; k++) {
+			double re, im;
+
+			bin(data, n, k, &re, &im);
+			peak = fmax(peak, hypot(refRe[k], refIm[k]));
+			err  = fmax(err, hypot(re - refRe[k], im - refIm[k]));
+		}
+		fft_inverse(&fft, data);
+		for (i = 0; i < n; i++) {
+			rtErr = fmax(rtErr, fabs(data[i] - input[i]));
+		}
+
+		/* Q15 forward (X / N) against the DFT of the Q15 input */
+		for (i = 0; i < n; i++) {
+			data[i]    = inputQ15[i] / 32768.0f;
+			dataQ15[i] = inputQ15[i];
+		}
+		dft(data, n);
+		fft_forwardQ15(&fft, dataQ15);
+		for (i = 0; i < n; i++) {
+			data[i] = dataQ15[i] * (float) n / 32768.0f;
+		}
+		for (k = 0; k <= n / 2; k++) {
+			double re, im;
+
+			bin(data, n, k, &re, &im);
+			sig   += refRe[k] * refRe[k] + refIm[k] * refIm[k];
+			noise += (re - refRe[k]) * (re - refRe[k]) + (im - refIm[k]) * (im - refIm[k]);
+		}
+		fft_inverseQ15(&fft, dataQ15);
+		for (i = 0; i < n; i++) {
+			rtSig   += (double) inputQ15[i] * inputQ15[i];
+			rtNoise += (double) (dataQ15[i] - inputQ15[i]) * (dataQ15[i] - inputQ15[i]);
+		}
+
+		tFwd    = timeIt(runFwd, &fft, data, repeats);
+		tInv    = timeIt(runInv, &fft, data, repeats);
+		tFwdQ15 = timeIt(runFwdQ15, &fft, dataQ15, repeats);
+		tInvQ15 = timeIt(runInvQ15, &fft, dataQ15, repeats);
+
+		printf("%5u  %.1e  %.1e  %6.1f dB  %7.1f dB  %7.2f  %7.2f  %9.2f  %9.2f\n",
+				n, err / peak, rtErr, 10.0 * log10(sig / noise), 10.0 * log10(rtSig / rtNoise),
+				tFwd, tInv, tFwdQ15, tInvQ15);
+	}
+	return 0;
+}
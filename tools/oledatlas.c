@@ -0,0 +1,155 @@
+/**
+ *@file oledatlas.c
+ *
+ *@brief
+ *  - offline generator: OLED meter atlas (C source)
+ *
+ * Writes the tables declared in src/oled_atlas.h: the page bytes of a bar
+ * column and of a peak marker for every height, and the band number glyphs
+ * already placed in their band and split into page bytes. Geometry comes
+ * from src/oled.h, the glyphs are drawn below as 5x9 pixel art. Rerun after
+ * changing either.
+ *
+ * Build (host):
+ *   gcc -O2 -Isrc -o oledatlas tools/oledatlas.c
+ * Usage:
+ *   oledatlas -o src/oled_atlas.c
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "oled.h"
+
+/* keep in sync with src/oled_atlas.h */
+#define OLED_NUM_PAGE0  (OLED_NUM_TOP / 8)
+#define OLED_NUM_PAGES  ((OLED_NUM_TOP + OLED_NUM_HEIGHT - 1) / 8 - OLED_NUM_PAGE0 + 1)
+
+/* band numbers 1..8, '#' = pixel on, top row first */
+static const char *glyphArt[OLED_BAND_NUM][OLED_NUM_HEIGHT] = {
+	{ "..#..", ".##..", "..#..", "..#..", "..#..", "..#..", "..#..", "..#..", ".###." },
+	{ ".###.", "#...#", "....#", "....#", "...#.", "..#..", ".#...", "#....", "#####" },
+	{ ".###.", "#...#", "....#", "....#", "..##.", "....#", "....#", "#...#", ".###." },
+	{ "...#.", "..##.", ".#.#.", "#..#.", "#..#.", "#####", "...#.", "...#.", "...#." },
+	{ "#####", "#....", "#....", "####.", "....#", "....#", "....#", "#...#", ".###." },
+	{ "..##.", ".#...", "#....", "#....", "####.", "#...#", "#...#", "#...#", ".###." },
+	{ "#####", "....#", "....#", "...#.", "...#.", "..#..", "..#..", ".#...", ".#..." },
+	{ ".###.", "#...#", "#...#", "#...#", ".###.", "#...#", "#...#", "#...#", ".###." },
+};
+
+/** column of 'height' bar pixels growing up from the bottom of the bar area */
+static uint64_t bar_column(unsigned int height)
+{
+	uint64_t bits = 0;
+	unsigned int r;
+
+	for (r = OLED_BAR_TOP + OLED_BAR_MAX - height; r < OLED_BAR_TOP + OLED_BAR_MAX; r++) {
+		bits |= (uint64_t) 1 << r;
+	}
+	return bits;
+}
+
+static void put_bytes(FILE *out, const uint8_t *p, unsigned int n)
+{
+	unsigned int i;
+
+	for (i = 0; i < n; i++) {
+		fprintf(out, "%s0x%02x", i ? ", " : " ", p[i]);
+	}
+}
+
+int main(int argc, char **argv) {
+	const char *outPath = NULL;
+	uint8_t bytes[OLED_PAGES];
+	uint64_t barMask = bar_column(OLED_BAR_MAX);
+	unsigned int h, p, i, c, r;
+	FILE *out;
+
+	if (3 == argc && !strcmp(argv[1], "-o")) {
+		outPath = argv[2];
+	}
+	if (NULL == outPath) {
+		fprintf(stderr, "usage: %s -o out.c\n", argv[0]);
+		return 1;
+	}
+
+	out = fopen(outPath, "w");
+	if (NULL == out) {
+		fprintf(stderr, "%s: cannot create\n", outPath);
+		return 1;
+	}
+
+	fprintf(out, "/**\n *@file oled_atlas.c\n *\n *@brief\n"
+	             " *  - OLED meter atlas, generated by tools/oledatlas.c - do not edit\n"
+	             " *\n *******************************************************************************/\n"
+	             "#include \"oled_atlas.h\"\n\n");
+
+	/* bar rows per page */
+	for (p = 0; p < OLED_PAGES; p++) {
+		bytes[p] = (uint8_t) (barMask >> (8 * p));
+	}
+	fprintf(out, "const uint8_t oled_atlasBarMask[OLED_PAGES] = {");
+	put_bytes(out, bytes, OLED_PAGES);
+	fprintf(out, " };\n\n");
+
+	/* bar column per height */
+	fprintf(out, "const uint8_t oled_atlasBar[OLED_BAR_MAX + 1][OLED_PAGES] = {\n");
+	for (h = 0; h <= OLED_BAR_MAX; h++) {
+		uint64_t bits = bar_column(h);
+
+		for (p = 0; p < OLED_PAGES; p++) {
+			bytes[p] = (uint8_t) (bits >> (8 * p));
+		}
+		fprintf(out, "\t{");
+		put_bytes(out, bytes, OLED_PAGES);
+		fprintf(out, " },  /* %2u */\n", h);
+	}
+	fprintf(out, "};\n\n");
+
+	/* peak marker per height: top row of the bar of that height */
+	fprintf(out, "const uint8_t oled_atlasPeak[OLED_BAR_MAX + 1][OLED_PAGES] = {\n");
+	for (h = 0; h <= OLED_BAR_MAX; h++) {
+		uint64_t bits = h ? bar_column(h) & ~bar_column(h - 1) : 0;
+
+		for (p = 0; p < OLED_PAGES; p++) {
+			bytes[p] = (uint8_t) (bits >> (8 * p));
+		}
+		fprintf(out, "\t{");
+		put_bytes(out, bytes, OLED_PAGES);
+		fprintf(out, " },  /* %2u */\n", h);
+	}
+	fprintf(out, "};\n\n");
+
+	/* numbers centered in their band */
+	fprintf(out, "const uint8_t oled_atlasNum[OLED_BAND_NUM][OLED_NUM_PAGES][OLED_BAND_WIDTH] = {\n");
+	for (i = 0; i < OLED_BAND_NUM; i++) {
+		uint8_t band[OLED_NUM_PAGES][OLED_BAND_WIDTH];
+		unsigned int first = (OLED_BAND_WIDTH - OLED_NUM_WIDTH) / 2;
+
+		memset(band, 0, sizeof(band));
+		for (r = 0; r < OLED_NUM_HEIGHT; r++) {
+			unsigned int row = OLED_NUM_TOP + r;
+
+			for (c = 0; c < OLED_NUM_WIDTH; c++) {
+				if ('#' == glyphArt[i][r][c]) {
+					band[row / 8 - OLED_NUM_PAGE0][first + c] |= 1 << (row % 8);
+				}
+			}
+		}
+
+		fprintf(out, "\t{  /* %u */\n", i + 1);
+		for (p = 0; p < OLED_NUM_PAGES; p++) {
+			fprintf(out, "\t\t{");
+			put_bytes(out, band[p], OLED_BAND_WIDTH);
+			fprintf(out, " },\n");
+		}
+		fprintf(out, "\t},\n");
+	}
+	fprintf(out, "};\n");
+
+	fclose(out);
+	return 0;
+}
@@ -0,0 +1,284 @@
+/**
+ *@file wav2adpcm.c
+ *
+ *@brief
+ *  - offline encoder: WAV clips -> IMA-ADPCM sample bank (C source)
+ *
+ * Reads 16 bit PCM WAV files (mono, or stereo which is mixed down to mono)
+ * at the player's sample rate (clips are not resampled)
+ * and writes one C file holding every clip as IMA-ADPCM blocks plus the
+ * snd_bank[] table used by audioSample_initClip(). The block layout matches
+ * the decoder in src/adpcm.c.
+ *
+ * Build (host):
+ *   gcc -O2 -o wav2adpcm tools/wav2adpcm.c
+ * Usage:
+ *   wav2adpcm [-b blockAlign] -o src/snd_bank.c clip1.wav [clip2.wav ...]
+ *
+ * LastChange:
+ * $Id$
+ *
+ *******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+/* keep in sync with src/adpcm.h */
+#define ADPCM_BLOCK_HEADER 4
+#define ADPCM_SAMPLES_PER_BLOCK(blockAlign) ((((blockAlign) - ADPCM_BLOCK_HEADER) * 2) + 1)
+
+/* keep in sync with AUDIO_SAMPLE_RATE in src/appConfig.h */
+#define TARGET_SAMPLE_RATE 48000
+
+/* default block size: 505 samples per 256 byte block */
+#define DEFAULT_BLOCK_ALIGN 256
+
+static const short stepTable[89] = {
+	    7,     8,     9,    10,    11,    12,    13,    14,    16,    17,
+	   19,    21,    23,    25,    28,    31,    34,    37,    41,    45,
+	   50,    55,    60,    66,    73,    80,    88,    97,   107,   118,
+	  130,   143,   157,   173,   190,   209,   230,   253,   279,   307,
+	  337,   371,   408,   449,   494,   544,   598,   658,   724,   796,
+	  876,   963,  1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,
+	 2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,
+	 5894,  6484,  7132,  7845,  8630,  9493, 10442, 11487, 12635, 13899,
+	15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+static const signed char indexTable[16] = {
+	-1, -1, -1, -1, 2, 4, 6, 8,
+	-1, -1, -1, -1, 2, 4, 6, 8
+};
+
+/** decoded WAV clip */
+typedef struct {
+	short        *pSamples;
+	unsigned int  nSamples;
+	unsigned int  sampleRate;
+} wav_t;
+
+static unsigned int rd16(const unsigned char *p) { return p[0] | (p[1] << 8); }
+static unsigned int rd32(const unsigned char *p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int) p[3] << 24); }
+
+/** Read a 16 bit PCM WAV file, stereo is mixed down to mono
+ *
+ * @return 0 on success, -1 on failure
+ */
+static int wav_read(const char *path, wav_t *pWav) {
+	FILE *fp = fopen(path, "rb");
+	unsigned char hdr[12], ck[8], fmt[16];
+	unsigned int channels = 0, bits = 0, n;
+	short *pRaw;
+
+	if (NULL == fp) {
+		fprintf(stderr, "%s: cannot open\n", path);
+		return -1;
+	}
+	if (fread(hdr, 1, 12, fp) != 12 || memcmp(hdr, "RIFF", 4) || memcmp(hdr + 8, "WAVE", 4)) {
+		fprintf(stderr, "%s: not a WAV file\n", path);
+		fclose(fp);
+		return -1;
+	}
+
+	/* walk the RIFF chunks until "data" */
+	while (fread(ck, 1, 8, fp) == 8) {
+		unsigned int size = rd32(ck + 4);
+
+		if (!memcmp(ck, "fmt ", 4)) {
+			if (size < 16 || fread(fmt, 1, 16, fp) != 16) {
+				break;
+			}
+			if (rd16(fmt) != 1) {
+				fprintf(stderr, "%s: only PCM supported\n", path);
+				break;
+			}
+			channels         = rd16(fmt + 2);
+			pWav->sampleRate = rd32(fmt + 4);
+			bits             = rd16(fmt + 14);
+			if (TARGET_SAMPLE_RATE != pWav->sampleRate) {
+				fprintf(stderr, "%s: %u Hz, need %u Hz\n", path, pWav->sampleRate, TARGET_SAMPLE_RATE);
+				break;
+			}
+			fseek(fp, (size - 16) + (size & 1), SEEK_CUR);
+		} else if (!memcmp(ck, "data", 4)) {
+			if (16 != bits || channels < 1 || channels > 2) {
+				fprintf(stderr, "%s: need 16 bit mono/stereo\n", path);
+				break;
+			}
+			pWav->nSamples = size / (2 * channels);
+			pRaw = malloc(size);
+			pWav->pSamples = malloc(pWav->nSamples * sizeof(short));
+			if (NULL == pRaw || NULL == pWav->pSamples || fread(pRaw, 1, size, fp) != size) {
+				fprintf(stderr, "%s: short read\n", path);
+				break;
+			}
+			for (n = 0; n < pWav->nSamples; n++) {
+				const unsigned char *p = (const unsigned char *) &pRaw[n * channels];
+				int s = (short) rd16(p);
+				if (2 == channels) {
+					s = (s + (short) rd16(p + 2)) / 2;
+				}
+				pWav->pSamples[n] = (short) s;
+			}
+			free(pRaw);
+			fclose(fp);
+			return 0;
+		} else {
+			fseek(fp, size + (size & 1), SEEK_CUR);
+		}
+	}
+
+	fclose(fp);
+	return -1;
+}
+
+/** Encode one sample, updates predictor/index exactly like the decoder
+ *
+ * @return 4 bit code
+ */
+static unsigned char adpcm_encodeSample(int sample, int *pPredictor, int *pIndex) {
+	int step = stepTable[*pIndex];
+	int diff = sample - *pPredictor;
+	int delta = step >> 3;
+	unsigned char code = 0;
+
+	if (diff < 0) {
+		code = 8;
+		diff = -diff;
+	}
+	if (diff >= step)        { code |= 4; diff -= step;        delta += step; }
+	if (diff >= (step >> 1)) { code |= 2; diff -= step >> 1;   delta += step >> 1; }
+	if (diff >= (step >> 2)) { code |= 1;                      delta += step >> 2; }
+
+	if (code & 8) {
+		*pPredictor -= delta;
+		if (*pPredictor < -32768) *pPredictor = -32768;
+	} else {
+		*pPredictor += delta;
+		if (*pPredictor > 32767) *pPredictor = 32767;
+	}
+
+	*pIndex += indexTable[code];
+	if (*pIndex < 0)  *pIndex = 0;
+	if (*pIndex > 88) *pIndex = 88;
+
+	return code;
+}
+
+/** Encode a whole clip into blocks (last block zero padded)
+ *
+ * @return number of bytes written to pOut
+ */
+static unsigned int adpcm_encodeClip(const wav_t *pWav, unsigned int blockAlign, unsigned char *pOut) {
+	unsigned int samplesPerBlock = ADPCM_SAMPLES_PER_BLOCK(blockAlign);
+	unsigned int nBlocks = (pWav->nSamples + samplesPerBlock - 1) / samplesPerBlock;
+	unsigned int block, n;
+	int index = 0;
+
+	memset(pOut, 0, nBlocks * blockAlign);
+
+	for (block = 0; block < nBlocks; block++) {
+		unsigned char *pBlock = &pOut[block * blockAlign];
+		unsigned int first = block * samplesPerBlock;
+		int predictor = pWav->pSamples[first];
+
+		/* header: first sample verbatim, step index carried over */
+		pBlock[0] = predictor & 0xFF;
+		pBlock[1] = (predictor >> 8) & 0xFF;
+		pBlock[2] = (unsigned char) index;
+		pBlock[3] = 0;
+
+		for (n = 1; n < samplesPerBlock && first + n < pWav->nSamples; n++) {
+			unsigned char code = adpcm_encodeSample(pWav->pSamples[first + n], &predictor, &index);
+			unsigned int c = n - 1;
+			pBlock[ADPCM_BLOCK_HEADER + (c >> 1)] |= (c & 1) ? (code << 4) : code;
+		}
+	}
+
+	return nBlocks * blockAlign;
+}
+
+/** derive a C identifier from a file path */
+static void clip_name(const char *path, char *pName, size_t len) {
+	const char *base = strrchr(path, '/');
+	size_t n = 0;
+
+	base = base ? base + 1 : path;
+	while (*base && '.' != *base && n + 1 < len) {
+		pName[n++] = isalnum((unsigned char) *base) ? *base : '_';
+		base++;
+	}
+	pName[n] = '\0';
+}
+
+int main(int argc, char **argv) {
+	unsigned int blockAlign = DEFAULT_BLOCK_ALIGN;
+	const char *outPath = NULL;
+	char names[64][64];
+	wav_t wav[64];
+	unsigned int nBytes[64];
+	int nClips = 0;
+	int arg, clip;
+	FILE *out;
+
+	for (arg = 1; arg < argc; arg++) {
+		if (!strcmp(argv[arg], "-b") && arg + 1 < argc) {
+			blockAlign = atoi(argv[++arg]);
+		} else if (!strcmp(argv[arg], "-o") && arg + 1 < argc) {
+			outPath = argv[++arg];
+		} else if (nClips < 64) {
+			if (wav_read(argv[arg], &wav[nClips]) != 0) {
+				return 1;
+			}
+			clip_name(argv[arg], names[nClips], sizeof(names[nClips]));
+			nClips++;
+		}
+	}
+
+	if (NULL == outPath || 0 == nClips || blockAlign <= ADPCM_BLOCK_HEADER || (blockAlign & 3)) {
+		fprintf(stderr, "usage: %s [-b blockAlign] -o out.c clip.wav [clip.wav ...]\n", argv[0]);
+		return 1;
+	}
+
+	out = fopen(outPath, "w");
+	if (NULL == out) {
+		fprintf(stderr, "%s: cannot create\n", outPath);
+		return 1;
+	}
+
+	fprintf(out, "/**\n *@file snd_bank.c\n *\n *@brief\n"
+	             " *  - IMA-ADPCM sample bank, generated by tools/wav2adpcm.c - do not edit\n"
+	             " *\n *******************************************************************************/\n"
+	             "#include \"adpcm.h\"\n\n");
+
+	for (clip = 0; clip < nClips; clip++) {
+		unsigned int samplesPerBlock = ADPCM_SAMPLES_PER_BLOCK(blockAlign);
+		unsigned int nBlocks = (wav[clip].nSamples + samplesPerBlock - 1) / samplesPerBlock;
+		unsigned char *pData = malloc(nBlocks * blockAlign);
+		unsigned int n;
+
+		nBytes[clip] = adpcm_encodeClip(&wav[clip], blockAlign, pData);
+
+		fprintf(out, "/* %s: %u samples @ %u Hz */\n", names[clip], wav[clip].nSamples, wav[clip].sampleRate);
+		fprintf(out, "static const unsigned char %s_adpcm[%u] = {", names[clip], nBytes[clip]);
+		for (n = 0; n < nBytes[clip]; n++) {
+			fprintf(out, "%s0x%02x,", (n % 16) ? " " : "\n\t", pData[n]);
+		}
+		fprintf(out, "\n};\n\n");
+		free(pData);
+
+		fprintf(stderr, "%s: %u samples -> %u bytes (%.1f:1 vs 32 bit words)\n", names[clip],
+		        wav[clip].nSamples, nBytes[clip], (4.0 * wav[clip].nSamples) / nBytes[clip]);
+	}
+
+	fprintf(out, "const adpcm_clip_t snd_bank[] = {\n");
+	for (clip = 0; clip < nClips; clip++) {
+		fprintf(out, "\t{ \"%s\", %s_adpcm, %u, %u, %u, %u },\n", names[clip], names[clip],
+		        nBytes[clip], blockAlign, wav[clip].nSamples, wav[clip].sampleRate);
+	}
+	fprintf(out, "};\n\nconst unsigned int snd_bank_nClips = %d;\n", nClips);
+
+	fclose(out);
+	return 0;
+}